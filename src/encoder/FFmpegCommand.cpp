@@ -0,0 +1,212 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <vector>
+#include <regex>
+#include <locale>
+#include <sstream>
+#include <iomanip>
+
+#include <boost/algorithm/string/predicate.hpp>
+
+#include "filter-generator/ScriptGenerator.hpp"
+
+#include "FFmpegCommand.hpp"
+
+using namespace mdl;
+
+
+FFmpegCommand::FFmpegCommand()
+  : codec_(Codec::H264)
+  , quality_(H264_DEFAULT_CRF_)
+  , preset_("medium")
+  , has_input_range_(false)
+  , input_start_(0)
+  , input_duration_(0)
+  , reencode_audio_(false)
+{
+}
+
+
+void FFmpegCommand::set_generator(Generator generator)
+{
+  generator_ = generator;
+}
+
+
+FFmpegCommand::Generator FFmpegCommand::generator() const
+{
+  return generator_;
+}
+
+
+void FFmpegCommand::set_input_file(const std::string& input_file)
+{
+  input_file_ = input_file;
+}
+
+
+void FFmpegCommand::set_codec(Codec codec)
+{
+  codec_ = codec;
+}
+
+
+void FFmpegCommand::set_quality(int quality)
+{
+  quality_ = quality;
+}
+
+
+void FFmpegCommand::set_preset(const std::string& preset)
+{
+  preset_ = preset;
+}
+
+
+void FFmpegCommand::set_output_file(const std::string& output_file)
+{
+  output_file_ = output_file;
+}
+
+
+void FFmpegCommand::set_input_range(double start, double duration)
+{
+  has_input_range_ = true;
+  input_start_ = start;
+  input_duration_ = duration;
+}
+
+
+void FFmpegCommand::set_reencode_audio(bool reencode_audio)
+{
+  reencode_audio_ = reencode_audio;
+}
+
+
+std::vector<std::string> FFmpegCommand::get_cmd_line(const std::string& filter_file) const
+{
+  std::string codec_name;
+  if (codec_ == Codec::H264) {
+    codec_name = "libx264";
+  } else if (codec_ == Codec::H265) {
+    codec_name = "libx265";
+  }
+
+  std::string quality_str = std::to_string(quality_);
+
+  std::vector<std::string> cmd_line;
+  cmd_line.push_back("ffmpeg");
+  cmd_line.push_back("-y");
+
+  if (has_input_range_) {
+    cmd_line.push_back("-ss"); cmd_line.push_back(format_time(input_start_));
+    cmd_line.push_back("-t"); cmd_line.push_back(format_time(input_duration_));
+  }
+  cmd_line.push_back("-i"); cmd_line.push_back(input_file_);
+  cmd_line.push_back("-/filter_complex"); cmd_line.push_back(filter_file);
+
+  cmd_line.push_back("-map"); cmd_line.push_back("[out_v]");
+  cmd_line.push_back("-c:v"); cmd_line.push_back(codec_name);
+  cmd_line.push_back("-crf"); cmd_line.push_back(quality_str);
+
+  std::vector<std::string> audio_opts = get_audio_opts();
+  cmd_line.insert(cmd_line.end(), audio_opts.begin(), audio_opts.end());
+
+  cmd_line.push_back("-preset"); cmd_line.push_back(preset_);
+
+  if (is_mp4_output()) {
+    cmd_line.push_back("-movflags"); cmd_line.push_back("+faststart");
+  }
+
+  cmd_line.push_back(output_file_);
+
+  return cmd_line;
+}
+
+
+std::vector<std::string> FFmpegCommand::get_concat_cmd_line(const std::string& list_file) const
+{
+  std::vector<std::string> cmd_line;
+  cmd_line.push_back("ffmpeg");
+  cmd_line.push_back("-y");
+
+  cmd_line.push_back("-f"); cmd_line.push_back("concat");
+  cmd_line.push_back("-safe"); cmd_line.push_back("0");
+  cmd_line.push_back("-i"); cmd_line.push_back(list_file);
+
+  cmd_line.push_back("-map"); cmd_line.push_back("0");
+  cmd_line.push_back("-c"); cmd_line.push_back("copy");
+
+  if (is_mp4_output()) {
+    cmd_line.push_back("-movflags"); cmd_line.push_back("+faststart");
+  }
+
+  cmd_line.push_back(output_file_);
+
+  return cmd_line;
+}
+
+
+std::vector<std::string> FFmpegCommand::get_audio_opts() const
+{
+  std::vector<std::string> audio_opts;
+
+  if (generator_->affects_audio()) {
+    audio_opts.push_back("-map"); audio_opts.push_back("[out_a]");
+    audio_opts.push_back("-c:a"); audio_opts.push_back("aac");
+    audio_opts.push_back("-b:a"); audio_opts.push_back("192k");
+  } else if (reencode_audio_) {
+    audio_opts.push_back("-map"); audio_opts.push_back("0:a?");
+    audio_opts.push_back("-c:a"); audio_opts.push_back("aac");
+    audio_opts.push_back("-b:a"); audio_opts.push_back("192k");
+  } else {
+    audio_opts.push_back("-map"); audio_opts.push_back("0:a?");
+    audio_opts.push_back("-c:a"); audio_opts.push_back("copy");
+  }
+
+  return audio_opts;
+}
+
+
+std::string FFmpegCommand::format_time(double time)
+{
+  std::ostringstream out;
+  out.imbue(std::locale::classic());
+  out << std::fixed << std::setprecision(6) << time;
+  return out.str();
+}
+
+
+bool FFmpegCommand::is_mp4_output() const
+{
+  return boost::algorithm::ends_with(output_file_, ".mp4");
+}
+
+
+int FFmpegCommand::get_frames_encoded(const std::string& ffmpeg_stats)
+{
+  std::regex r("^frame=\\s+(\\d+)");
+  std::smatch matches;
+  if (!std::regex_search(ffmpeg_stats, matches, r)) {
+    return -1;
+  }
+
+  return std::stoi(matches[1].str());
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MDL_FFMPEG_COMMAND_H
+#define MDL_FFMPEG_COMMAND_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "filter-generator/ScriptGenerator.hpp"
+
+
+namespace mdl {
+  /**
+   * Builds the ffmpeg command line for an encode. It has no
+   * dependency on glib, so it is shared by the GUI and the
+   * command line encoder.
+   */
+  class FFmpegCommand
+  {
+  public:
+    enum class Codec { H264, H265 };
+    static const int H264_DEFAULT_CRF_ = 23;
+    static const int H265_DEFAULT_CRF_ = 28;
+
+    typedef std::shared_ptr<fg::ScriptGenerator> Generator;
+
+  public:
+    FFmpegCommand();
+
+    void set_generator(Generator generator);
+    Generator generator() const;
+
+    void set_input_file(const std::string& input_file);
+    void set_codec(Codec codec);
+    void set_quality(int quality);
+    void set_preset(const std::string& preset);
+    void set_output_file(const std::string& output_file);
+
+    /** Encodes only part of the input, starting at start seconds */
+    void set_input_range(double start, double duration);
+    /** Encodes the audio even when no filter changes it, instead of copying it */
+    void set_reencode_audio(bool reencode_audio);
+
+    std::vector<std::string> get_cmd_line(const std::string& filter_file) const;
+    /** Command line that joins the files in a concat list into the output, without encoding */
+    std::vector<std::string> get_concat_cmd_line(const std::string& list_file) const;
+
+    /** Returns the frame count of an ffmpeg stats line, or -1 if it is not one */
+    static int get_frames_encoded(const std::string& ffmpeg_stats);
+
+  private:
+    Generator generator_;
+
+    std::string input_file_;
+    Codec codec_;
+    int quality_;
+    std::string preset_;
+    std::string output_file_;
+    bool has_input_range_;
+    double input_start_;
+    double input_duration_;
+    bool reencode_audio_;
+
+    bool is_mp4_output() const;
+    std::vector<std::string> get_audio_opts() const;
+    static std::string format_time(double time);
+  };
+}
+
+#endif // MDL_FFMPEG_COMMAND_H
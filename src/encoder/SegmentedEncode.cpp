@@ -0,0 +1,281 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstdio>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <map>
+#include <utility>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include <sys/stat.h>
+
+#include "filter-generator/FilterList.hpp"
+#include "filter-generator/Filters.hpp"
+#include "filter-generator/RegularScriptGenerator.hpp"
+
+#include "FFmpegCommand.hpp"
+#include "SegmentedEncode.hpp"
+
+using namespace mdl;
+
+
+const std::string SegmentedEncode::MANIFEST_HEADER_ = "multi-delogo segments 1";
+
+
+SegmentedEncode::SegmentedEncode(const fg::FilterList& filter_list, const FFmpegCommand& command,
+                                 int frame_width, int frame_height, double fps, int total_frames,
+                                 fg::maybe_int scale_width, fg::maybe_int scale_height,
+                                 bool drawbox_timeline,
+                                 const std::string& work_dir, int segment_frames)
+  : filter_list_(filter_list)
+  , command_(command)
+  , frame_width_(frame_width)
+  , frame_height_(frame_height)
+  , fps_(fps)
+  , scale_width_(scale_width)
+  , scale_height_(scale_height)
+  , drawbox_timeline_(drawbox_timeline)
+  , work_dir_(work_dir)
+{
+  create_segments(total_frames, segment_frames, load_manifest());
+}
+
+
+const std::vector<SegmentedEncode::Segment>& SegmentedEncode::segments() const
+{
+  return segments_;
+}
+
+
+int SegmentedEncode::frames_to_encode() const
+{
+  int frames = 0;
+  for (const auto& segment: segments_) {
+    if (!segment.up_to_date) {
+      frames += segment.output_frames;
+    }
+  }
+  return frames;
+}
+
+
+void SegmentedEncode::create_segments(int total_frames, int segment_frames, const Manifest& previous)
+{
+  for (int start = 0; start < total_frames; start += segment_frames) {
+    int end = std::min(start + segment_frames, total_frames);
+
+    Segment segment;
+    if (!create_segment(start, end, segment)) {
+      // Completely cut
+      continue;
+    }
+
+    struct stat info;
+    auto previous_hash = previous.find(std::make_pair(start, end));
+    segment.up_to_date = previous_hash != previous.end()
+      && previous_hash->second == segment.hash
+      && stat(segment.file.c_str(), &info) == 0;
+
+    segments_.push_back(segment);
+  }
+}
+
+
+bool SegmentedEncode::create_segment(int start_frame, int end_frame, Segment& segment)
+{
+  segment.start_frame = start_frame;
+  segment.end_frame = end_frame;
+
+  // The filters that apply to the segment, with the start frames
+  // moved so that the segment starts at frame 1
+  segment.filter_list = std::make_shared<fg::FilterList>();
+  bool has_filters = false;
+  for (auto i = filter_list_.begin(); i != filter_list_.end(); ++i) {
+    auto next = std::next(i);
+    int filter_start = i->first - 1;
+    int filter_end = next == filter_list_.end() ? end_frame : next->first - 1;
+    if (filter_start >= end_frame || filter_end <= start_frame) {
+      continue;
+    }
+
+    segment.filter_list->insert(std::max(filter_start, start_frame) - start_frame + 1, i->second);
+    has_filters = has_filters || i->second->type() != fg::FilterType::NO_OP;
+  }
+
+  auto generator = fg::RegularScriptGenerator::create(*segment.filter_list,
+                                                      frame_width_, frame_height_, fps_,
+                                                      scale_width_, scale_height_);
+  generator->set_cuts_first(true);
+  generator->set_drawbox_timeline(drawbox_timeline_);
+
+  std::ostringstream script;
+  if (has_filters) {
+    generator->generate_ffmpeg_script(script);
+  } else {
+    // ffmpeg needs at least one filter in the graph
+    script << "[0:v]null[out_v]";
+  }
+  segment.script = script.str();
+  segment.output_frames = generator->resulting_frames(end_frame - start_frame);
+  if (segment.output_frames <= 0) {
+    return false;
+  }
+
+  char name[32];
+  snprintf(name, sizeof(name), "segment-%08d.mkv", start_frame);
+  segment.file = work_dir_ + "/" + name;
+
+  segment.command = command_;
+  segment.command.set_generator(generator);
+  segment.command.set_input_range(get_time(start_frame), get_time(end_frame) - get_time(start_frame));
+  segment.command.set_reencode_audio(true);
+  segment.command.set_output_file(segment.file);
+
+  // The filter file name changes every time, so it is left out
+  std::string cmd_line;
+  for (const auto& arg: segment.command.get_cmd_line("")) {
+    cmd_line += arg + '\n';
+  }
+  segment.hash = hash(segment.script + '\n' + cmd_line);
+  segment.up_to_date = false;
+
+  return true;
+}
+
+
+double SegmentedEncode::get_time(int frame) const
+{
+  // Half a frame earlier, so that rounding doesn't skip the frame
+  return std::max(0., (frame - 0.5) / fps_);
+}
+
+
+std::vector<std::string> SegmentedEncode::get_segment_cmd_line(const Segment& segment,
+                                                               const std::string& filter_file) const
+{
+  return segment.command.get_cmd_line(filter_file);
+}
+
+
+std::vector<std::string> SegmentedEncode::get_concat_cmd_line() const
+{
+  return command_.get_concat_cmd_line(concat_list_file());
+}
+
+
+void SegmentedEncode::write_concat_list() const
+{
+  std::ofstream out(concat_list_file());
+  if (!out.is_open()) {
+    throw SegmentedEncodeException(concat_list_file());
+  }
+
+  // ffmpeg resolves the names relative to the list, which is in the
+  // same directory as the segments
+  out << "ffconcat version 1.0\n";
+  for (const auto& segment: segments_) {
+    out << "file '" << segment.file.substr(work_dir_.size() + 1) << "'\n";
+  }
+}
+
+
+void SegmentedEncode::mark_encoded(std::size_t index)
+{
+  segments_[index].up_to_date = true;
+  save_manifest();
+}
+
+
+/**
+ * 64 bit FNV-1a hash, as a hexadecimal string.
+ */
+std::string SegmentedEncode::hash(const std::string& data)
+{
+  uint64_t h = 14695981039346656037ULL;
+  for (unsigned char c: data) {
+    h ^= c;
+    h *= 1099511628211ULL;
+  }
+
+  char buf[17];
+  snprintf(buf, sizeof(buf), "%016llx", (unsigned long long) h);
+  return buf;
+}
+
+
+std::string SegmentedEncode::manifest_file() const
+{
+  return work_dir_ + "/manifest";
+}
+
+
+std::string SegmentedEncode::concat_list_file() const
+{
+  return work_dir_ + "/segments.ffconcat";
+}
+
+
+SegmentedEncode::Manifest SegmentedEncode::load_manifest() const
+{
+  Manifest manifest;
+
+  std::ifstream in(manifest_file());
+  std::string line;
+  if (!std::getline(in, line) || line != MANIFEST_HEADER_) {
+    return manifest;
+  }
+
+  while (std::getline(in, line)) {
+    std::istringstream line_in(line);
+    int start, end;
+    std::string segment_hash;
+    if (line_in >> start >> end >> segment_hash) {
+      manifest[std::make_pair(start, end)] = segment_hash;
+    }
+  }
+
+  return manifest;
+}
+
+
+void SegmentedEncode::save_manifest() const
+{
+  // Written to a new file and renamed, so an interrupted encode
+  // doesn't leave a corrupt manifest
+  std::string tmp_file = manifest_file() + ".new";
+  {
+    std::ofstream out(tmp_file);
+    if (!out.is_open()) {
+      throw SegmentedEncodeException(tmp_file);
+    }
+
+    out << MANIFEST_HEADER_ << "\n";
+    for (const auto& segment: segments_) {
+      if (segment.up_to_date) {
+        out << segment.start_frame << " " << segment.end_frame << " " << segment.hash << "\n";
+      }
+    }
+  }
+
+  std::rename(tmp_file.c_str(), manifest_file().c_str());
+}
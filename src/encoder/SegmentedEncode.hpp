@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MDL_SEGMENTED_ENCODE_H
+#define MDL_SEGMENTED_ENCODE_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <map>
+#include <utility>
+#include <exception>
+
+#include "filter-generator/FilterList.hpp"
+#include "filter-generator/RegularScriptGenerator.hpp"
+
+#include "FFmpegCommand.hpp"
+
+
+namespace mdl {
+  class SegmentedEncodeException : public std::exception
+  {
+  public:
+    SegmentedEncodeException(const std::string& file)
+      : msg_("Could not write " + file) { }
+
+    const char* what() const throw() override
+    {
+      return msg_.c_str();
+    }
+
+  private:
+    std::string msg_;
+  };
+
+
+  /**
+   * Encodes a project in segments of the input video, each one to its
+   * own file in a work directory, and then joins them without encoding
+   * again.
+   *
+   * A manifest in the work directory records a hash of the filter
+   * script and of the ffmpeg command line of each segment. When the
+   * project is encoded again, only the segments whose hash changed
+   * need to be encoded. Each segment starts with a keyframe, so they
+   * can be joined with the concat demuxer.
+   */
+  class SegmentedEncode
+  {
+  public:
+    static const int DEFAULT_SEGMENT_SECONDS_ = 60;
+
+    class Segment
+    {
+    public:
+      /** First frame of the input, 0-based */
+      int start_frame;
+      /** Frame after the last one */
+      int end_frame;
+      int output_frames;
+      std::string script;
+      std::string hash;
+      std::string file;
+      bool up_to_date;
+
+      std::shared_ptr<fg::FilterList> filter_list;
+      FFmpegCommand command;
+    };
+
+    /**
+     * The command has the encoder settings, input and output
+     * files. Its generator is not used; each segment gets its own.
+     */
+    SegmentedEncode(const fg::FilterList& filter_list, const FFmpegCommand& command,
+                    int frame_width, int frame_height, double fps, int total_frames,
+                    fg::maybe_int scale_width, fg::maybe_int scale_height,
+                    bool drawbox_timeline,
+                    const std::string& work_dir, int segment_frames);
+
+    const std::vector<Segment>& segments() const;
+    /** Output frames of the segments that are not up to date */
+    int frames_to_encode() const;
+
+    std::vector<std::string> get_segment_cmd_line(const Segment& segment,
+                                                  const std::string& filter_file) const;
+    std::vector<std::string> get_concat_cmd_line() const;
+
+    void write_concat_list() const;
+
+    /** Records that a segment was encoded, updating the manifest */
+    void mark_encoded(std::size_t index);
+
+    static std::string hash(const std::string& data);
+
+  private:
+    const fg::FilterList& filter_list_;
+    FFmpegCommand command_;
+    int frame_width_;
+    int frame_height_;
+    double fps_;
+    fg::maybe_int scale_width_;
+    fg::maybe_int scale_height_;
+    bool drawbox_timeline_;
+    std::string work_dir_;
+
+    std::vector<Segment> segments_;
+
+    typedef std::map<std::pair<int, int>, std::string> Manifest;
+
+    static const std::string MANIFEST_HEADER_;
+
+
+    void create_segments(int total_frames, int segment_frames, const Manifest& previous);
+    bool create_segment(int start_frame, int end_frame, Segment& segment);
+    double get_time(int frame) const;
+
+    std::string manifest_file() const;
+    std::string concat_list_file() const;
+    Manifest load_manifest() const;
+    void save_manifest() const;
+  };
+}
+
+#endif // MDL_SEGMENTED_ENCODE_H
@@ -0,0 +1,556 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <unistd.h>
+#include <getopt.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/stat.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+
+#include <opencv2/videoio.hpp>
+
+#include "filter-generator/FilterData.hpp"
+#include "filter-generator/RegularScriptGenerator.hpp"
+#include "filter-generator/FuzzyScriptGenerator.hpp"
+#include "filter-generator/Exceptions.hpp"
+
+#include "FFmpegCommand.hpp"
+#include "SegmentedEncode.hpp"
+
+using namespace mdl;
+
+
+namespace {
+  struct Options
+  {
+    FFmpegCommand::Codec codec = FFmpegCommand::Codec::H264;
+    int quality = -1;
+    std::string preset = "medium";
+    fg::maybe_int scale_width;
+    fg::maybe_int scale_height;
+    double fuzzyness = 0;
+    bool drawbox_timeline = false;
+    std::string script_file;
+    std::string work_dir;
+    std::string project_file;
+    std::string output_file;
+  };
+
+  struct VideoInfo
+  {
+    int width;
+    int height;
+    int number_of_frames;
+    double fps;
+  };
+
+  pid_t ffmpeg_pid = 0;
+}
+
+
+static void usage(std::ostream& out);
+static bool parse_options(int argc, char* argv[], Options& options);
+static bool parse_scale(const std::string& scale, Options& options);
+static bool load_project(const std::string& project_file, fg::FilterData& filter_data);
+static bool get_video_info(const std::string& movie_file, VideoInfo& info);
+static std::string create_tmp_file();
+static bool write_script(const std::string& filter_file, fg::ScriptGenerator& generator);
+static int encode_incremental(fg::FilterData& filter_data, const FFmpegCommand& command,
+                              const VideoInfo& info, const Options& options);
+static int run_ffmpeg(const std::vector<std::string>& cmd_line,
+                      int frames_done, int total_frames,
+                      std::chrono::steady_clock::time_point start);
+static int report_finished(int exit_code);
+static void report_progress(int frames_encoded, int total_frames,
+                            std::chrono::steady_clock::time_point start);
+static void forward_signal(int signal);
+
+
+int main(int argc, char* argv[])
+{
+  Options options;
+  if (!parse_options(argc, argv, options)) {
+    usage(std::cerr);
+    return 1;
+  }
+
+  fg::FilterData filter_data;
+  if (!load_project(options.project_file, filter_data)) {
+    return 2;
+  }
+
+  VideoInfo info;
+  if (!get_video_info(filter_data.movie_file(), info)) {
+    return 2;
+  }
+
+  std::shared_ptr<fg::RegularScriptGenerator> generator;
+  if (options.fuzzyness > 0) {
+    generator = fg::FuzzyScriptGenerator::create(filter_data.filter_list(),
+                                                 info.width, info.height, info.fps,
+                                                 options.fuzzyness,
+                                                 options.scale_width, options.scale_height);
+  } else {
+    generator = fg::RegularScriptGenerator::create(filter_data.filter_list(),
+                                                   info.width, info.height, info.fps,
+                                                   options.scale_width, options.scale_height);
+  }
+  generator->set_cuts_first(true);
+  generator->set_drawbox_timeline(options.drawbox_timeline);
+
+  if (!options.script_file.empty()) {
+    return write_script(options.script_file, *generator) ? 0 : 2;
+  }
+
+  FFmpegCommand command;
+  command.set_generator(generator);
+  command.set_input_file(filter_data.movie_file());
+  command.set_codec(options.codec);
+  if (options.quality < 0) {
+    options.quality = options.codec == FFmpegCommand::Codec::H264
+      ? FFmpegCommand::H264_DEFAULT_CRF_
+      : FFmpegCommand::H265_DEFAULT_CRF_;
+  }
+  command.set_quality(options.quality);
+  command.set_preset(options.preset);
+  command.set_output_file(options.output_file);
+
+  if (!options.work_dir.empty()) {
+    return encode_incremental(filter_data, command, info, options);
+  }
+
+  std::string filter_file = create_tmp_file();
+  if (filter_file.empty() || !write_script(filter_file, *generator)) {
+    return 2;
+  }
+
+  int total_frames = generator->resulting_frames(info.number_of_frames);
+  std::cout << "started total=" << total_frames << std::endl;
+  int exit_code = run_ffmpeg(command.get_cmd_line(filter_file),
+                             0, total_frames, std::chrono::steady_clock::now());
+  ::unlink(filter_file.c_str());
+
+  return report_finished(exit_code);
+}
+
+
+void usage(std::ostream& out)
+{
+  out << "Usage: multi-delogo-encode [options] <project> <output>\n"
+      << "       multi-delogo-encode [options] --script=<file> <project>\n"
+      << "\n"
+      << "Options:\n"
+      << "  -c, --codec=h264|h265  Video codec (default h264)\n"
+      << "  -q, --crf=N            Quality (default 23 for h264, 28 for h265)\n"
+      << "  -p, --preset=PRESET    Encoder preset (default medium)\n"
+      << "  -s, --scale=WxH        Scale the output\n"
+      << "  -z, --fuzzy=N          Fuzzy filter boundaries, with the given fuzzyness\n"
+      << "  -t, --drawbox-timeline Use a single drawbox moved by sendcmd (not with --fuzzy)\n"
+      << "  -I, --incremental=DIR  Encode in segments kept in DIR, and only encode again\n"
+      << "                         the segments that changed since the last run (not with --fuzzy)\n"
+      << "      --script=FILE      Only generate the ffmpeg filter script\n"
+      << "  -h, --help             Show this message\n"
+      << "\n"
+      << "Progress is reported on standard output, starting with\n"
+      << "  started total=<n>\n"
+      << "and then one line per update:\n"
+      << "  progress frame=<n> total=<n> percentage=<p> elapsed=<s> remaining=<s>\n"
+      << "followed by a final line with the result:\n"
+      << "  finished status=ok\n"
+      << "  finished status=error exit_code=<n>\n";
+}
+
+
+bool parse_options(int argc, char* argv[], Options& options)
+{
+  static const option long_options[] = {
+    {"codec",  required_argument, nullptr, 'c'},
+    {"crf",    required_argument, nullptr, 'q'},
+    {"preset", required_argument, nullptr, 'p'},
+    {"scale",  required_argument, nullptr, 's'},
+    {"fuzzy",  required_argument, nullptr, 'z'},
+    {"drawbox-timeline", no_argument, nullptr, 't'},
+    {"incremental", required_argument, nullptr, 'I'},
+    {"script", required_argument, nullptr, 'S'},
+    {"help",   no_argument,       nullptr, 'h'},
+    {nullptr,  0,                 nullptr, 0}
+  };
+
+  int opt;
+  while ((opt = getopt_long(argc, argv, "c:q:p:s:z:tI:h", long_options, nullptr)) != -1) {
+    switch (opt) {
+    case 'c':
+      if (strcmp(optarg, "h264") == 0) {
+        options.codec = FFmpegCommand::Codec::H264;
+      } else if (strcmp(optarg, "h265") == 0) {
+        options.codec = FFmpegCommand::Codec::H265;
+      } else {
+        std::cerr << "Invalid codec " << optarg << std::endl;
+        return false;
+      }
+      break;
+
+    case 'q':
+      options.quality = atoi(optarg);
+      break;
+
+    case 'p':
+      options.preset = optarg;
+      break;
+
+    case 's':
+      if (!parse_scale(optarg, options)) {
+        std::cerr << "Invalid scale " << optarg << std::endl;
+        return false;
+      }
+      break;
+
+    case 'z':
+      options.fuzzyness = atof(optarg);
+      break;
+
+    case 't':
+      options.drawbox_timeline = true;
+      break;
+
+    case 'I':
+      options.work_dir = optarg;
+      break;
+
+    case 'S':
+      options.script_file = optarg;
+      break;
+
+    case 'h':
+      usage(std::cout);
+      exit(0);
+
+    default:
+      return false;
+    }
+  }
+
+  if (!options.work_dir.empty() && options.fuzzyness > 0) {
+    std::cerr << "--incremental cannot be used with --fuzzy" << std::endl;
+    return false;
+  }
+
+  int positional = argc - optind;
+  if (positional == 1 && !options.script_file.empty()) {
+    options.project_file = argv[optind];
+    return true;
+  }
+  if (positional == 2 && options.script_file.empty()) {
+    options.project_file = argv[optind];
+    options.output_file = argv[optind + 1];
+    return true;
+  }
+
+  return false;
+}
+
+
+bool parse_scale(const std::string& scale, Options& options)
+{
+  int width, height;
+  char extra;
+  if (sscanf(scale.c_str(), "%dx%d%c", &width, &height, &extra) != 2
+      || width <= 0 || height <= 0) {
+    return false;
+  }
+
+  options.scale_width = width;
+  options.scale_height = height;
+  return true;
+}
+
+
+bool load_project(const std::string& project_file, fg::FilterData& filter_data)
+{
+  std::ifstream project_stream(project_file);
+  if (!project_stream.is_open()) {
+    std::cerr << "Could not open " << project_file << ": " << strerror(errno) << std::endl;
+    return false;
+  }
+
+  try {
+    filter_data.load(project_stream);
+  } catch (fg::Exception& e) {
+    std::cerr << "Invalid data in file " << project_file << std::endl;
+    return false;
+  }
+
+  if (filter_data.filter_list().empty()) {
+    std::cerr << project_file << ": there are no filters" << std::endl;
+    return false;
+  }
+
+  if (filter_data.filter_list().has_review_filter()) {
+    std::cerr << project_file << ": encoding cannot be done when there are 'review' filters" << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+
+bool get_video_info(const std::string& movie_file, VideoInfo& info)
+{
+  cv::VideoCapture video(movie_file);
+  if (!video.isOpened()) {
+    std::cerr << "Could not open video " << movie_file << std::endl;
+    return false;
+  }
+
+  info.width = video.get(cv::CAP_PROP_FRAME_WIDTH);
+  info.height = video.get(cv::CAP_PROP_FRAME_HEIGHT);
+  info.number_of_frames = video.get(cv::CAP_PROP_FRAME_COUNT);
+  info.fps = video.get(cv::CAP_PROP_FPS);
+  return true;
+}
+
+
+std::string create_tmp_file()
+{
+  const char* tmp_dir = getenv("TMPDIR");
+  std::string tmp_template = std::string(tmp_dir ? tmp_dir : "/tmp") + "/mdlfilterXXXXXX";
+
+  std::vector<char> name(tmp_template.begin(), tmp_template.end());
+  name.push_back('\0');
+
+  int fd = mkstemp(name.data());
+  if (fd == -1) {
+    std::cerr << "Could not create temporary file: " << strerror(errno) << std::endl;
+    return "";
+  }
+  ::close(fd);
+
+  return name.data();
+}
+
+
+bool write_script(const std::string& filter_file, fg::ScriptGenerator& generator)
+{
+  std::ofstream filter_stream(filter_file);
+  if (!filter_stream.is_open()) {
+    std::cerr << "Could not write " << filter_file << ": " << strerror(errno) << std::endl;
+    return false;
+  }
+  generator.generate_ffmpeg_script(filter_stream);
+  return true;
+}
+
+
+int encode_incremental(fg::FilterData& filter_data, const FFmpegCommand& command,
+                       const VideoInfo& info, const Options& options)
+{
+  if (mkdir(options.work_dir.c_str(), 0777) == -1 && errno != EEXIST) {
+    std::cerr << "Could not create " << options.work_dir << ": " << strerror(errno) << std::endl;
+    return 2;
+  }
+
+  int segment_frames = std::max(1, (int) (SegmentedEncode::DEFAULT_SEGMENT_SECONDS_ * info.fps));
+
+  try {
+    SegmentedEncode encode(filter_data.filter_list(), command,
+                           info.width, info.height, info.fps, info.number_of_frames,
+                           options.scale_width, options.scale_height,
+                           options.drawbox_timeline,
+                           options.work_dir, segment_frames);
+
+    int total_frames = encode.frames_to_encode();
+    std::cout << "started total=" << total_frames << std::endl;
+    auto start = std::chrono::steady_clock::now();
+
+    int frames_done = 0;
+    const auto& segments = encode.segments();
+    for (std::size_t i = 0; i < segments.size(); ++i) {
+      if (segments[i].up_to_date) {
+        continue;
+      }
+
+      std::string filter_file = create_tmp_file();
+      if (filter_file.empty()) {
+        return 2;
+      }
+      std::ofstream filter_stream(filter_file);
+      filter_stream << segments[i].script;
+      filter_stream.close();
+      if (!filter_stream) {
+        std::cerr << "Could not write " << filter_file << std::endl;
+        ::unlink(filter_file.c_str());
+        return 2;
+      }
+
+      int exit_code = run_ffmpeg(encode.get_segment_cmd_line(segments[i], filter_file),
+                                 frames_done, total_frames, start);
+      ::unlink(filter_file.c_str());
+      if (exit_code != 0) {
+        return report_finished(exit_code);
+      }
+
+      encode.mark_encoded(i);
+      frames_done += segments[i].output_frames;
+    }
+
+    // Joining doesn't encode, so it counts as already done
+    encode.write_concat_list();
+    int exit_code = run_ffmpeg(encode.get_concat_cmd_line(),
+                               total_frames, total_frames, start);
+    return report_finished(exit_code);
+  } catch (SegmentedEncodeException& e) {
+    std::cerr << e.what() << std::endl;
+    return 2;
+  }
+}
+
+
+/**
+ * Runs ffmpeg, reporting progress as if frames_done frames had
+ * already been encoded before it started. Returns ffmpeg's exit code.
+ */
+int run_ffmpeg(const std::vector<std::string>& cmd_line,
+               int frames_done, int total_frames,
+               std::chrono::steady_clock::time_point start)
+{
+  int stderr_pipe[2];
+  if (pipe(stderr_pipe) == -1) {
+    std::cerr << "Could not create pipe: " << strerror(errno) << std::endl;
+    return 127;
+  }
+
+  std::vector<char*> argv;
+  for (const std::string& arg : cmd_line) {
+    argv.push_back(const_cast<char*>(arg.c_str()));
+  }
+  argv.push_back(nullptr);
+
+  ffmpeg_pid = fork();
+  if (ffmpeg_pid == -1) {
+    std::cerr << "Could not start ffmpeg: " << strerror(errno) << std::endl;
+    return 127;
+  }
+
+  if (ffmpeg_pid == 0) {
+    ::close(stderr_pipe[0]);
+    dup2(stderr_pipe[1], STDERR_FILENO);
+    if (!freopen("/dev/null", "w", stdout)) {
+      _exit(127);
+    }
+    execvp(argv[0], argv.data());
+    fprintf(stderr, "Could not execute %s: %s\n", argv[0], strerror(errno));
+    _exit(127);
+  }
+
+  ::close(stderr_pipe[1]);
+  signal(SIGINT, forward_signal);
+  signal(SIGTERM, forward_signal);
+
+  // ffmpeg separates its stats lines with \r, so lines are split by hand
+  std::string log;
+  std::string line;
+  char buffer[4096];
+  ssize_t n;
+  while ((n = read(stderr_pipe[0], buffer, sizeof(buffer))) != 0) {
+    if (n == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      break;
+    }
+
+    for (ssize_t i = 0; i < n; ++i) {
+      if (buffer[i] != '\r' && buffer[i] != '\n') {
+        line += buffer[i];
+        continue;
+      }
+
+      int frames_encoded = FFmpegCommand::get_frames_encoded(line);
+      if (frames_encoded >= 0) {
+        report_progress(std::min(frames_done + frames_encoded, total_frames), total_frames, start);
+      } else if (!line.empty()) {
+        log += line;
+        log += '\n';
+      }
+      line.clear();
+    }
+  }
+  ::close(stderr_pipe[0]);
+
+  int status;
+  while (waitpid(ffmpeg_pid, &status, 0) == -1 && errno == EINTR) {
+  }
+
+  int exit_code = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+  if (exit_code != 0) {
+    std::cerr << log;
+  }
+  return exit_code;
+}
+
+
+int report_finished(int exit_code)
+{
+  if (exit_code == 0) {
+    std::cout << "finished status=ok" << std::endl;
+    return 0;
+  }
+
+  std::cout << "finished status=error exit_code=" << exit_code << std::endl;
+  return 3;
+}
+
+
+void report_progress(int frames_encoded, int total_frames,
+                     std::chrono::steady_clock::time_point start)
+{
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  double percentage = total_frames > 0 ? (double) frames_encoded / total_frames : 0;
+
+  std::cout << std::fixed << std::setprecision(4)
+            << "progress frame=" << frames_encoded
+            << " total=" << total_frames
+            << " percentage=" << percentage
+            << std::setprecision(1)
+            << " elapsed=" << elapsed.count();
+  if (percentage > 0) {
+    std::cout << " remaining=" << elapsed.count() / percentage - elapsed.count();
+  }
+  std::cout << std::endl;
+}
+
+
+void forward_signal(int signal)
+{
+  if (ffmpeg_pid > 0) {
+    kill(ffmpeg_pid, signal);
+  }
+}
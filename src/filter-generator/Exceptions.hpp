@@ -66,6 +66,16 @@ namespace fg {
         return "Invalid filter data file";
     }
   };
+
+
+  class JournalNotOpenedException : public Exception
+  {
+  public:
+    virtual const char* what() const throw()
+    {
+        return "Could not open journal file";
+    }
+  };
 }
 
 
@@ -25,6 +25,7 @@
 #include "IOUtils.hpp"
 #include "FilterData.hpp"
 #include "FilterList.hpp"
+#include "FilterJournal.hpp"
 
 using namespace fg;
 
@@ -34,17 +35,24 @@ const std::string FilterData::HEADER_ = "MDLV1";
 
 FilterData::FilterData()
   : jump_size_(500)
+  , journal_(nullptr)
 {
 }
 
 
 void FilterData::set_movie_file(const std::string& movie_file)
 {
+  if (journal_ && movie_file != movie_file_) {
+    journal_->record_movie_file(movie_file);
+  }
   movie_file_ = movie_file;
 }
 
 void FilterData::set_jump_size(int jump_size)
 {
+  if (journal_ && jump_size != jump_size_) {
+    journal_->record_jump_size(jump_size);
+  }
   jump_size_ = jump_size;
 }
 
@@ -67,6 +75,13 @@ FilterList& FilterData::filter_list()
 }
 
 
+void FilterData::set_journal(FilterJournal* journal)
+{
+  journal_ = journal;
+  filter_list_.set_journal(journal);
+}
+
+
 bool FilterData::is_filter_data(std::istream& in)
 {
   char header[HEADER_.size()];
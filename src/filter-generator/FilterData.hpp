@@ -27,6 +27,9 @@
 
 
 namespace fg {
+  class FilterJournal;
+
+
   class FilterData
   {
   public:
@@ -39,6 +42,9 @@ namespace fg {
     int jump_size() const;
     FilterList& filter_list();
 
+    /** Changes are recorded in journal from now on */
+    void set_journal(FilterJournal* journal);
+
     static bool is_filter_data(std::istream& in);
     void load(std::istream& in);
     void save(std::ostream& out) const;
@@ -49,6 +55,7 @@ namespace fg {
     std::string movie_file_;
     int jump_size_;
     FilterList filter_list_;
+    FilterJournal* journal_;
   };
 }
 
@@ -0,0 +1,248 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstdio>
+#include <string>
+#include <istream>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#include "Exceptions.hpp"
+#include "IOUtils.hpp"
+#include "Filters.hpp"
+#include "FilterFactory.hpp"
+#include "FilterData.hpp"
+#include "FilterJournal.hpp"
+
+using namespace fg;
+
+
+const std::string FilterJournal::HEADER_ = "MDLJ1";
+
+
+FilterJournal::FilterJournal(const std::string& project_file)
+  : file_(file_for(project_file))
+  , previous_file_(previous_file_for(project_file))
+  , records_(0)
+{
+  open();
+}
+
+
+void FilterJournal::record_insert(int start_frame, const Filter& filter)
+{
+  out_ << "I;" << start_frame << ';' << filter.save_str() << '\n';
+  ++records_;
+}
+
+
+void FilterJournal::record_remove(int start_frame)
+{
+  out_ << "R;" << start_frame << '\n';
+  ++records_;
+}
+
+
+void FilterJournal::record_movie_file(const std::string& movie_file)
+{
+  out_ << "M;" << movie_file << '\n';
+  ++records_;
+}
+
+
+void FilterJournal::record_jump_size(int jump_size)
+{
+  out_ << "J;" << jump_size << '\n';
+  ++records_;
+}
+
+
+void FilterJournal::flush()
+{
+  out_.flush();
+}
+
+
+int FilterJournal::records() const
+{
+  return records_;
+}
+
+
+void FilterJournal::rotate()
+{
+  if (std::ifstream(previous_file_).is_open()) {
+    return;
+  }
+
+  out_.close();
+  std::rename(file_.c_str(), previous_file_.c_str());
+  open();
+  records_ = 0;
+}
+
+
+void FilterJournal::remove_previous()
+{
+  std::remove(previous_file_.c_str());
+}
+
+
+bool FilterJournal::replay(const std::string& project_file, FilterData& filter_data)
+{
+  // The previous file has the older records
+  bool replayed = false;
+  for (const auto& file: {previous_file_for(project_file), file_for(project_file)}) {
+    std::ifstream in(file);
+    if (in.is_open() && replay(in, filter_data)) {
+      replayed = true;
+    }
+  }
+  return replayed;
+}
+
+
+bool FilterJournal::replay(std::istream& in, FilterData& filter_data)
+{
+  std::string line;
+  if (!fg::getline(in, line)) {
+    return false;
+  }
+  if (line != HEADER_) {
+    throw InvalidFilterDataException();
+  }
+
+  bool replayed = false;
+  while (fg::getline(in, line)) {
+    // A record without a line break was interrupted while written
+    if (in.eof()) {
+      break;
+    }
+    if (!line.empty()) {
+      apply(line, filter_data);
+      replayed = true;
+    }
+  }
+  return replayed;
+}
+
+
+void FilterJournal::remove(const std::string& project_file)
+{
+  std::remove(previous_file_for(project_file).c_str());
+  std::remove(file_for(project_file).c_str());
+}
+
+
+void FilterJournal::open()
+{
+  std::string contents;
+  {
+    std::ifstream in(file_, std::ios::binary);
+    contents.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+  if (!contents.empty() && contents.back() != '\n') {
+    drop_incomplete_record(contents);
+  }
+  bool exists = !contents.empty();
+
+  out_.open(file_, std::ios::app);
+  if (!out_.is_open()) {
+    throw JournalNotOpenedException();
+  }
+
+  if (!exists) {
+    out_ << HEADER_ << '\n';
+    out_.flush();
+  }
+}
+
+
+/**
+ * Removes the record that a crash interrupted at the end of the file,
+ * since the next record appended would be joined to it
+ */
+void FilterJournal::drop_incomplete_record(std::string& contents)
+{
+  auto pos = contents.find_last_of('\n');
+  contents.erase(pos == std::string::npos ? 0 : pos + 1);
+
+  std::string tmp_file = file_ + ".tmp";
+  std::ofstream out(tmp_file, std::ios::binary);
+  out << contents;
+  out.close();
+  if (!out || std::rename(tmp_file.c_str(), file_.c_str()) != 0) {
+    std::remove(tmp_file.c_str());
+    throw JournalNotOpenedException();
+  }
+}
+
+
+std::string FilterJournal::file_for(const std::string& project_file)
+{
+  return project_file + ".journal";
+}
+
+
+std::string FilterJournal::previous_file_for(const std::string& project_file)
+{
+  return project_file + ".journal.old";
+}
+
+
+void FilterJournal::apply(const std::string& record, FilterData& filter_data)
+{
+  if (record.size() < 2 || record[1] != ';') {
+    throw InvalidFilterDataException();
+  }
+  std::string value = record.substr(2);
+
+  try {
+    switch (record[0]) {
+    case 'I': {
+      auto pos = value.find_first_of(';');
+      if (pos == std::string::npos) {
+        throw InvalidFilterDataException();
+      }
+      filter_data.filter_list().insert(std::stoi(value.substr(0, pos)),
+                                       FilterFactory::load(value.substr(pos + 1)));
+      break;
+    }
+
+    case 'R':
+      filter_data.filter_list().remove(std::stoi(value));
+      break;
+
+    case 'M':
+      filter_data.set_movie_file(value);
+      break;
+
+    case 'J':
+      filter_data.set_jump_size(std::stoi(value));
+      break;
+
+    default:
+      throw InvalidFilterDataException();
+    }
+  } catch (std::invalid_argument& e) {
+    throw InvalidFilterDataException();
+  } catch (std::out_of_range& e) {
+    throw InvalidFilterDataException();
+  }
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef FG_FILTER_JOURNAL_H
+#define FG_FILTER_JOURNAL_H
+
+#include <string>
+#include <istream>
+#include <fstream>
+
+#include "Filters.hpp"
+
+
+namespace fg {
+  class FilterData;
+
+  /**
+   * Changes made to a project since it was last written whole,
+   * appended to a file next to it as they are made. Records are
+   * buffered until flush(), which is left to the caller so that
+   * editing doesn't wait for the disk. A project whose program
+   * crashed is recovered by replaying its journal.
+   *
+   * Each record sets or removes a value, instead of describing an
+   * operation, so replaying the records over any version of the
+   * project written after the journal started gives the same result.
+   * That allows writing the project again while changes are still
+   * recorded.
+   */
+  class FilterJournal
+  {
+  public:
+    /**
+     * Appends to the journal of project_file, creating it if
+     * necessary. Throws JournalNotOpenedException
+     */
+    explicit FilterJournal(const std::string& project_file);
+
+    FilterJournal(const FilterJournal&) = delete;
+    FilterJournal& operator=(const FilterJournal&) = delete;
+
+    void record_insert(int start_frame, const Filter& filter);
+    void record_remove(int start_frame);
+    void record_movie_file(const std::string& movie_file);
+    void record_jump_size(int jump_size);
+    /** Writes the records so far to the file */
+    void flush();
+
+    /** Records in the current file */
+    int records() const;
+
+    /**
+     * Starts a new file, used when the project is about to be written
+     * whole. The records so far are kept in the previous file, to be
+     * replayed if writing the project fails, until remove_previous()
+     * is called. If a previous file is still there, it is kept and
+     * the current file goes on, since the project has not been
+     * written with its records yet.
+     */
+    void rotate();
+    void remove_previous();
+
+    /**
+     * Applies the journals of project_file to filter_data, which must
+     * have been loaded from project_file. Returns false if there was
+     * nothing to apply. Throws InvalidFilterDataException
+     */
+    static bool replay(const std::string& project_file, FilterData& filter_data);
+    /**
+     * Applies the records in, up to the first incomplete one. Throws
+     * InvalidFilterDataException
+     */
+    static bool replay(std::istream& in, FilterData& filter_data);
+    /** Removes the journals of project_file, after writing it whole */
+    static void remove(const std::string& project_file);
+
+  private:
+    const static std::string HEADER_;
+
+    std::string file_;
+    std::string previous_file_;
+    std::ofstream out_;
+    int records_;
+
+    void open();
+    void drop_incomplete_record(std::string& contents);
+    static std::string file_for(const std::string& project_file);
+    static std::string previous_file_for(const std::string& project_file);
+    static void apply(const std::string& record, FilterData& filter_data);
+  };
+}
+
+#endif // FG_FILTER_JOURNAL_H
@@ -18,6 +18,9 @@
  */
 #include <string>
 #include <map>
+#include <vector>
+#include <utility>
+#include <iterator>
 #include <istream>
 #include <ostream>
 #include <limits>
@@ -29,23 +32,38 @@
 #include "IOUtils.hpp"
 #include "Filters.hpp"
 #include "FilterFactory.hpp"
+#include "FilterJournal.hpp"
 #include "FilterList.hpp"
 
 using namespace fg;
 
 
+void FilterList::set_journal(FilterJournal* journal)
+{
+  journal_ = journal;
+}
+
+
 void FilterList::insert(int start_frame, filter_ptr filter)
 {
-  remove(start_frame);
-  filters_.insert(std::pair<int, filter_ptr>(start_frame, filter));
+  filters_[start_frame] = filter;
+
+  if (journal_) {
+    journal_->record_insert(start_frame, *filter);
+  }
 }
 
 
 void FilterList::remove(int start_frame)
 {
   auto iter = filters_.find(start_frame);
-  if (iter != end()) {
-    filters_.erase(iter);
+  if (iter == end()) {
+    return;
+  }
+  filters_.erase(iter);
+
+  if (journal_) {
+    journal_->record_remove(start_frame);
   }
 }
 
@@ -57,9 +75,54 @@ void FilterList::change_start_frame(int old_start_frame, int new_start_frame)
     return;
   }
 
-  remove(new_start_frame);
-  filters_.insert(std::pair<int, filter_ptr>(new_start_frame, iter->second));
-  filters_.erase(old_start_frame);
+  filter_ptr filter = iter->second;
+  filters_.erase(iter);
+  filters_[new_start_frame] = filter;
+
+  if (journal_) {
+    journal_->record_remove(old_start_frame);
+    journal_->record_insert(new_start_frame, *filter);
+  }
+}
+
+
+std::pair<int, int> FilterList::shift(int start, int end, int amount)
+{
+  auto first = filters_.lower_bound(start);
+  auto last = filters_.upper_bound(end);
+  if (first == last) {
+    return std::make_pair(0, 0);
+  }
+
+  std::vector<value_type> shifted(first, last);
+  filters_.erase(first, last);
+
+  // The shifted filters are in order, so each one goes right after
+  // the previous
+  auto hint = filters_.lower_bound(shifted.front().first + amount);
+  for (auto& filter: shifted) {
+    int start_frame = filter.first + amount;
+    while (hint != filters_.end() && hint->first < start_frame) {
+      ++hint;
+    }
+    if (hint != filters_.end() && hint->first == start_frame) {
+      hint->second = filter.second;
+    } else {
+      hint = filters_.emplace_hint(hint, start_frame, filter.second);
+    }
+    ++hint;
+  }
+
+  if (journal_) {
+    for (auto& filter: shifted) {
+      journal_->record_remove(filter.first);
+    }
+    for (auto& filter: shifted) {
+      journal_->record_insert(filter.first + amount, *filter.second);
+    }
+  }
+
+  return std::make_pair(shifted.front().first, shifted.back().first);
 }
 
 
@@ -158,6 +221,41 @@ bool FilterList::has_review_filter() const
 }
 
 
+std::vector<std::pair<int, int>> FilterList::spans_of_type(FilterType type, int last_frame) const
+{
+  std::vector<std::pair<int, int>> spans;
+  for (auto i = begin(); i != end(); ++i) {
+    if (i->second->type() != type) {
+      continue;
+    }
+
+    auto next = std::next(i);
+    int span_end = next == end() ? last_frame : next->first - 1;
+    if (span_end >= i->first) {
+      spans.push_back(std::make_pair(i->first, span_end));
+    }
+  }
+
+  return spans;
+}
+
+
+void FilterList::merge(const FilterList& other, int from_frame)
+{
+  if (journal_) {
+    for (auto i = filters_.lower_bound(from_frame); i != filters_.end(); ++i) {
+      journal_->record_remove(i->first);
+    }
+    for (auto i = other.filters_.lower_bound(from_frame); i != other.filters_.end(); ++i) {
+      journal_->record_insert(i->first, *i->second);
+    }
+  }
+
+  filters_.erase(filters_.lower_bound(from_frame), filters_.end());
+  filters_.insert(other.filters_.lower_bound(from_frame), other.filters_.end());
+}
+
+
 void FilterList::load(std::istream& in)
 {
   std::string line;
@@ -178,7 +276,7 @@ void FilterList::load_line(const std::string& line)
     int start_frame = std::stoi(line.substr(0, pos));
     filter_ptr filter = filter_ptr(FilterFactory::load(line.substr(pos + 1)));
 
-    insert(start_frame, filter);
+    filters_[start_frame] = filter;
   } catch (std::invalid_argument& e) {
     throw InvalidFilterException();
   }
@@ -22,6 +22,8 @@
 #include <memory>
 #include <string>
 #include <map>
+#include <vector>
+#include <utility>
 #include <istream>
 #include <ostream>
 
@@ -31,6 +33,9 @@
 
 
 namespace fg {
+  class FilterJournal;
+
+
   class FilterList
   {
   public:
@@ -45,9 +50,22 @@ namespace fg {
     FilterList (const FilterList&) = delete;
     FilterList& operator=(const FilterList&) = delete;
 
+    /**
+     * Changes are recorded in journal from now on. Changes made by
+     * load() are not recorded, since they are already in the file.
+     */
+    void set_journal(FilterJournal* journal);
+
     void insert(int start_frame, filter_ptr filter);
     void remove(int start_frame);
     void change_start_frame(int old_start_frame, int new_start_frame);
+    /**
+     * Adds amount to the start frame of the filters starting in
+     * [start, end], replacing the filters already at the new start
+     * frames. Returns the first and last start frames shifted,
+     * before the shift, or (0, 0) if there were none.
+     */
+    std::pair<int, int> shift(int start, int end, int amount);
 
     bool empty() const;
     size_type size() const;
@@ -61,6 +79,18 @@ namespace fg {
     maybe_type get_filter_for_frame(int frame) const;
 
     bool has_review_filter() const;
+    /**
+     * Frames [first, last] where filters of a type are applied. The
+     * last filter is applied until last_frame.
+     */
+    std::vector<std::pair<int, int>> spans_of_type(FilterType type, int last_frame) const;
+
+    /**
+     * Replaces the filters starting at or after from_frame with the
+     * filters of other starting there. Used to combine lists
+     * generated for consecutive parts of a video.
+     */
+    void merge(const FilterList& other, int from_frame);
 
     void load(std::istream& in);
     void save(std::ostream& out) const;
@@ -68,6 +98,7 @@ namespace fg {
 
   private:
     std::map<int, filter_ptr> filters_;
+    FilterJournal* journal_ = nullptr;
 
     void load_line(const std::string& line);
   };
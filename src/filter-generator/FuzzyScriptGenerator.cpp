@@ -79,6 +79,13 @@ std::string FuzzyScriptGenerator::get_enable_expression(int start_frame, maybe_i
 }
 
 
+bool FuzzyScriptGenerator::use_drawbox_timeline() const
+{
+  // The fuzzy intervals overlap, which a single drawbox can't do
+  return false;
+}
+
+
 int FuzzyScriptGenerator::adjust_start(int start_frame) const
 {
   int new_start = start_frame - rng()*length_;
@@ -47,6 +47,7 @@ namespace fg {
 
   protected:
     std::string get_enable_expression(int start_frame, maybe_int next_start_frame) const override;
+    bool use_drawbox_timeline() const override;
 
   private:
     std::function<double()> rng;
@@ -23,6 +23,9 @@
 #include <algorithm>
 #include <numeric>
 #include <clocale>
+#include <locale>
+#include <sstream>
+#include <iomanip>
 
 #include <boost/algorithm/string/join.hpp>
 #include <boost/optional.hpp>
@@ -34,6 +37,9 @@
 using namespace fg;
 
 
+const std::string RegularScriptGenerator::DRAWBOX_TIMELINE_TARGET_ = "drawbox@mdl_box";
+
+
 RegularScriptGenerator::RegularScriptGenerator(const FilterList& filter_list,
                                                int frame_width, int frame_height, double fps,
                                                maybe_int scale_width, maybe_int scale_height)
@@ -43,7 +49,10 @@ RegularScriptGenerator::RegularScriptGenerator(const FilterList& filter_list,
   , scale_width_(scale_width)
   , scale_height_(scale_height)
   , first_filter_(true)
+  , cuts_first_(false)
+  , drawbox_timeline_(false)
 {
+  fps_value_ = fps;
   fps_ = make_fps_str(fps);
 }
 
@@ -65,6 +74,18 @@ std::shared_ptr<RegularScriptGenerator> RegularScriptGenerator::create(const Fil
 }
 
 
+void RegularScriptGenerator::set_cuts_first(bool cuts_first)
+{
+  cuts_first_ = cuts_first;
+}
+
+
+void RegularScriptGenerator::set_drawbox_timeline(bool drawbox_timeline)
+{
+  drawbox_timeline_ = drawbox_timeline;
+}
+
+
 bool RegularScriptGenerator::affects_audio() const
 {
   return std::any_of(filter_list_.begin(), filter_list_.end(),
@@ -78,23 +99,34 @@ void RegularScriptGenerator::generate_ffmpeg_script(std::ostream& out) const
     return;
   }
 
+  collect_cuts();
+
   out << "[0:v]\n";
-  generate_ffmpeg_script_standard_filters(out);
-  generate_ffmpeg_script_cuts(out);
+  if (cuts_first_) {
+    generate_ffmpeg_script_cuts(out);
+    generate_ffmpeg_script_standard_filters(out);
+  } else {
+    generate_ffmpeg_script_standard_filters(out);
+    generate_ffmpeg_script_cuts(out);
+  }
   generate_ffmpeg_script_scale(out);
   out << "\n[out_v]";
   generate_ffmpeg_script_audio(out);
 }
 
 
-void RegularScriptGenerator::generate_ffmpeg_script_standard_filters(std::ostream& out) const
+void RegularScriptGenerator::collect_cuts() const
 {
+  cuts_.clear();
+
   FilterList::const_iterator i = filter_list_.begin();
 
   while (i != filter_list_.end()) {
     auto& current = *i++;
 
-    filter_ptr filter = current.second;
+    if (current.second->type() != fg::FilterType::CUT) {
+      continue;
+    }
 
     int start = current.first - 1;
     maybe_int next_start;
@@ -103,11 +135,40 @@ void RegularScriptGenerator::generate_ffmpeg_script_standard_filters(std::ostrea
       next_start = boost::make_optional(next.first - 1);
     }
 
+    process_cut_filter(start, next_start);
+  }
+}
+
+
+void RegularScriptGenerator::generate_ffmpeg_script_standard_filters(std::ostream& out) const
+{
+  bool drawbox_timeline = use_drawbox_timeline();
+
+  FilterList::const_iterator i = filter_list_.begin();
+
+  while (i != filter_list_.end()) {
+    auto& current = *i++;
+
+    filter_ptr filter = current.second;
     if (filter->type() == fg::FilterType::CUT) {
-      process_cut_filter(start, next_start);
-    } else {
-      process_standard_filter(filter, start, next_start, out);
+      continue;
+    }
+    if (drawbox_timeline && filter->type() == fg::FilterType::DRAWBOX) {
+      continue;
+    }
+
+    int start = current.first - 1;
+    maybe_int next_start;
+    if (i != filter_list_.end()) {
+      auto& next = *i;
+      next_start = boost::make_optional(next.first - 1);
     }
+
+    process_standard_filter(filter, start, next_start, out);
+  }
+
+  if (drawbox_timeline) {
+    generate_ffmpeg_script_drawbox_timeline(out);
   }
 }
 
@@ -130,6 +191,66 @@ void RegularScriptGenerator::process_cut_filter(int start_frame, maybe_int next_
 }
 
 
+bool RegularScriptGenerator::use_drawbox_timeline() const
+{
+  if (!drawbox_timeline_) {
+    return false;
+  }
+
+  auto drawboxes = std::count_if(filter_list_.begin(), filter_list_.end(),
+                                 [](auto& f) { return f.second->type() == FilterType::DRAWBOX; });
+  return drawboxes >= 2;
+}
+
+
+void RegularScriptGenerator::generate_ffmpeg_script_drawbox_timeline(std::ostream& out) const
+{
+  std::vector<std::string> commands;
+  filter_ptr first_drawbox;
+
+  FilterList::const_iterator i = filter_list_.begin();
+
+  while (i != filter_list_.end()) {
+    auto& current = *i++;
+
+    filter_ptr filter = current.second;
+    if (cuts_first_ && filter->type() == fg::FilterType::CUT) {
+      // The frames were already removed
+      continue;
+    }
+
+    int start = current.first - 1;
+    maybe_int next_start;
+    if (i != filter_list_.end()) {
+      auto& next = *i;
+      next_start = boost::make_optional(next.first - 1);
+    }
+
+    std::string command = get_sendcmd_interval(start, next_start) + " ";
+    if (filter->type() == fg::FilterType::DRAWBOX) {
+      if (!first_drawbox) {
+        first_drawbox = filter;
+      }
+      auto box = std::static_pointer_cast<RectangularFilter>(filter);
+      command += DRAWBOX_TIMELINE_TARGET_ + " x " + std::to_string(box->x()) + ", "
+        + DRAWBOX_TIMELINE_TARGET_ + " y " + std::to_string(box->y()) + ", "
+        + DRAWBOX_TIMELINE_TARGET_ + " w " + std::to_string(box->width()) + ", "
+        + DRAWBOX_TIMELINE_TARGET_ + " h " + std::to_string(box->height()) + ", "
+        + DRAWBOX_TIMELINE_TARGET_ + " enable 1";
+    } else {
+      command += DRAWBOX_TIMELINE_TARGET_ + " enable 0";
+    }
+    commands.push_back(command);
+  }
+
+  out << separator() << "sendcmd=c='" << boost::algorithm::join(commands, ";\n") << "'";
+
+  // Starts disabled, until the first command is executed
+  std::string drawbox = first_drawbox->ffmpeg_str("enable='0'", frame_width_, frame_height_);
+  out << separator() << DRAWBOX_TIMELINE_TARGET_ << drawbox.substr(drawbox.find('='));
+}
+
+
 void RegularScriptGenerator::generate_ffmpeg_script_cuts(std::ostream& out) const
 {
   if (cuts_.empty()) {
@@ -185,6 +306,13 @@ std::string RegularScriptGenerator::separator() const
 
 std::string RegularScriptGenerator::get_enable_expression(int start_frame, maybe_int next_start_frame) const
 {
+  if (cuts_first_) {
+    start_frame = rebase_frame(start_frame);
+    if (next_start_frame) {
+      next_start_frame = rebase_frame(*next_start_frame);
+    }
+  }
+
   return "enable='" + get_frame_expression(start_frame, next_start_frame) + "'";
 }
 
@@ -200,6 +328,48 @@ std::string RegularScriptGenerator::get_frame_expression(int start_frame, maybe_
 }
 
 
+std::string RegularScriptGenerator::get_sendcmd_interval(int start_frame, maybe_int next_start_frame) const
+{
+  std::string interval = get_sendcmd_time(start_frame);
+  if (next_start_frame) {
+    interval += "-" + get_sendcmd_time(*next_start_frame);
+  }
+  return interval;
+}
+
+
+std::string RegularScriptGenerator::get_sendcmd_time(int frame) const
+{
+  if (cuts_first_) {
+    frame = rebase_frame(frame);
+  }
+
+  // Half a frame before the frame's timestamp, so that rounding
+  // doesn't make the command be executed one frame late
+  double time = std::max(0., (frame - 0.5) / fps_value_);
+
+  std::ostringstream out;
+  out.imbue(std::locale::classic());
+  out << std::fixed << std::setprecision(6) << time;
+  return out.str();
+}
+
+
+int RegularScriptGenerator::rebase_frame(int frame) const
+{
+  int cut_before = 0;
+  for (const auto& cut: cuts_) {
+    if (cut.first >= frame) {
+      continue;
+    }
+    int cut_end = cut.second ? std::min(*cut.second, frame) : frame;
+    cut_before += cut_end - cut.first;
+  }
+
+  return frame - cut_before;
+}
+
+
 std::string RegularScriptGenerator::get_audio_expression(int start_frame, maybe_int next_start_frame) const
 {
   if (next_start_frame) {
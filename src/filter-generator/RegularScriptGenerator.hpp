@@ -45,6 +45,21 @@ namespace fg {
                                                           int frame_width, int frame_height, double fps,
                                                           maybe_int scale_width, maybe_int scale_height);
 
+    /**
+     * Puts the select that removes the cut frames before the other
+     * filters, so they don't process frames that are discarded. The
+     * enable expressions are rebased on the frame numbers after the
+     * cuts, so the result is the same.
+     */
+    void set_cuts_first(bool cuts_first);
+
+    /**
+     * Uses a single drawbox filter, moved, resized and disabled by a
+     * sendcmd timeline, instead of one drawbox for each filter in the
+     * list. It is only used if there are at least two drawbox filters.
+     */
+    void set_drawbox_timeline(bool drawbox_timeline);
+
     bool affects_audio() const override;
     void generate_ffmpeg_script(std::ostream& out) const override;
     int resulting_frames(int original_frames) const override;
@@ -54,15 +69,22 @@ namespace fg {
     int frame_width_;
     int frame_height_;
     std::string fps_;
+    double fps_value_;
     maybe_int scale_width_;
     maybe_int scale_height_;
     mutable int first_filter_;
+    bool cuts_first_;
+    bool drawbox_timeline_;
+
+    static const std::string DRAWBOX_TIMELINE_TARGET_;
 
     mutable std::vector<std::pair<int, maybe_int>> cuts_;
 
     std::string make_fps_str(double fps);
 
+    void collect_cuts() const;
     void generate_ffmpeg_script_standard_filters(std::ostream& out) const;
+    void generate_ffmpeg_script_drawbox_timeline(std::ostream& out) const;
     void generate_ffmpeg_script_cuts(std::ostream& out) const;
     void generate_ffmpeg_script_scale(std::ostream& out) const;
     void generate_ffmpeg_script_audio(std::ostream& out) const;
@@ -73,8 +95,14 @@ namespace fg {
                                  std::ostream& out) const;
     void process_cut_filter(int start_frame, maybe_int next_start_frame) const;
 
+    virtual bool use_drawbox_timeline() const;
+    std::string get_sendcmd_interval(int start_frame, maybe_int next_start_frame) const;
+    std::string get_sendcmd_time(int frame) const;
+
     virtual std::string get_enable_expression(int start_frame, maybe_int next_start_frame) const;
     std::string get_frame_expression(int start_frame, maybe_int next_start_frame) const;
+    // Frame number after the cuts are removed; frames inside a cut map to the frame after it
+    int rebase_frame(int frame) const;
     std::string get_audio_expression(int start_frame, maybe_int next_start_frame) const;
   };
 }
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MDL_FRAME_CACHE_H
+#define MDL_FRAME_CACHE_H
+
+#include <cstddef>
+#include <list>
+#include <unordered_map>
+
+
+namespace mdl {
+  /**
+   * Decoded frames by frame number, limited to a number of bytes.
+   * When full, the frames used least recently are dropped. Frame is
+   * expected to share its data when copied, like cv::Mat, so a frame
+   * dropped from the cache stays valid for whoever is using it. Not
+   * thread safe.
+   */
+  template <typename Frame>
+  class FrameCache
+  {
+  public:
+    explicit FrameCache(std::size_t max_bytes)
+      : max_bytes_(max_bytes)
+      , bytes_(0) { }
+
+    FrameCache(const FrameCache&) = delete;
+    FrameCache& operator=(const FrameCache&) = delete;
+
+
+    /** Returns false if the frame is not in the cache */
+    bool get(int frame_number, Frame& frame) {
+      auto i = entries_.find(frame_number);
+      if (i == entries_.end()) {
+        return false;
+      }
+
+      lru_.splice(lru_.begin(), lru_, i->second.lru);
+      frame = i->second.frame;
+      return true;
+    }
+
+
+    /**
+     * A frame larger than the cache is kept until another frame is
+     * added.
+     */
+    void put(int frame_number, const Frame& frame, std::size_t bytes) {
+      remove(frame_number);
+
+      lru_.push_front(frame_number);
+      entries_.emplace(frame_number, Entry{frame, bytes, lru_.begin()});
+      bytes_ += bytes;
+
+      while (bytes_ > max_bytes_ && lru_.size() > 1) {
+        remove(lru_.back());
+      }
+    }
+
+
+    std::size_t size() const {
+      return entries_.size();
+    }
+
+
+    std::size_t bytes() const {
+      return bytes_;
+    }
+
+  private:
+    struct Entry
+    {
+      Frame frame;
+      std::size_t bytes;
+      std::list<int>::iterator lru;
+    };
+
+    std::size_t max_bytes_;
+    std::size_t bytes_;
+    // Most recently used first
+    std::list<int> lru_;
+    std::unordered_map<int, Entry> entries_;
+
+
+    void remove(int frame_number) {
+      auto i = entries_.find(frame_number);
+      if (i == entries_.end()) {
+        return;
+      }
+
+      bytes_ -= i->second.bytes;
+      lru_.erase(i->second.lru);
+      entries_.erase(i);
+    }
+  };
+}
+
+#endif // MDL_FRAME_CACHE_H
@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <memory>
+#include <map>
+#include <mutex>
+#include <limits>
+#include <condition_variable>
+
+#include <opencv2/core.hpp>
+
+#include "gui/common/Exceptions.hpp"
+#include "opencv-logo-finder/VideoSource.hpp"
+
+#include "FrameService.hpp"
+
+using namespace mdl;
+
+
+std::shared_ptr<FrameService> FrameService::for_file(const std::string& file)
+{
+  static std::mutex mutex;
+  static std::map<std::string, std::weak_ptr<FrameService>> services;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto service = services[file].lock();
+  if (!service) {
+    service = std::make_shared<FrameService>(file);
+    services[file] = service;
+  }
+  return service;
+}
+
+
+FrameService::FrameService(const std::string& file)
+  : file_(file)
+  , decoder_(opencv::open_video_source(file))
+  , decoder_position_(0)
+  , cache_(CACHE_BYTES_)
+  , display_requests_(0)
+{
+  frame_width_ = decoder_->get_frame_width();
+  frame_height_ = decoder_->get_frame_height();
+  number_of_frames_ = decoder_->get_number_of_frames();
+  fps_ = decoder_->get_fps();
+}
+
+
+int FrameService::get_frame_width() const
+{
+  return frame_width_;
+}
+
+
+int FrameService::get_frame_height() const
+{
+  return frame_height_;
+}
+
+
+int FrameService::get_number_of_frames() const
+{
+  return number_of_frames_;
+}
+
+
+double FrameService::get_fps() const
+{
+  return fps_;
+}
+
+
+cv::Mat FrameService::get_frame(int frame_number)
+{
+  cv::Mat frame;
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    if (cache_.get(frame_number, frame)) {
+      return frame;
+    }
+    ++display_requests_;
+  }
+
+  bool success;
+  {
+    std::lock_guard<std::mutex> lock(decoder_mutex_);
+    success = decode(*decoder_, decoder_position_, frame_number, frame);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    if (success) {
+      cache_.put(frame_number, frame, frame.total() * frame.elemSize());
+    }
+    --display_requests_;
+  }
+  display_done_.notify_all();
+
+  if (!success) {
+    throw FrameNotAvailableException(frame_number);
+  }
+  return frame;
+}
+
+
+bool FrameService::find_in_cache(int frame_number, cv::Mat& frame)
+{
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  return cache_.get(frame_number, frame);
+}
+
+
+void FrameService::put_in_cache(int frame_number, const cv::Mat& frame)
+{
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  cache_.put(frame_number, frame, frame.total() * frame.elemSize());
+}
+
+
+void FrameService::wait_for_display()
+{
+  std::unique_lock<std::mutex> lock(cache_mutex_);
+  display_done_.wait(lock, [this] { return display_requests_ == 0; });
+}
+
+
+/**
+ * Decodes frame_number with decoder, whose next frame is position.
+ * Frames a little ahead are reached by decoding the ones in between,
+ * instead of seeking.
+ */
+bool FrameService::decode(opencv::VideoSource& decoder, int& position,
+                          int frame_number, cv::Mat& frame)
+{
+  if (frame_number < position || frame_number - position > MAX_SKIPPED_FRAMES_) {
+    decoder.seek(frame_number);
+    position = frame_number;
+  }
+
+  while (position < frame_number) {
+    if (!decoder.grab()) {
+      // Forces a seek on the next call
+      position = std::numeric_limits<int>::max();
+      return false;
+    }
+    ++position;
+  }
+
+  // retrieve() must not reuse the memory of a frame in the cache
+  frame = cv::Mat();
+  if (!decoder.grab() || !decoder.retrieve(frame)) {
+    position = std::numeric_limits<int>::max();
+    return false;
+  }
+  ++position;
+  return true;
+}
+
+
+FrameService::Reader::Reader(std::shared_ptr<FrameService> service)
+  : service_(service)
+  , decoder_position_(0)
+{
+}
+
+
+bool FrameService::Reader::read(int frame_number, cv::Mat& frame)
+{
+  if (service_->find_in_cache(frame_number, frame)) {
+    return true;
+  }
+
+  service_->wait_for_display();
+
+  if (!decoder_) {
+    decoder_ = opencv::open_video_source(service_->file_);
+  }
+  if (!decode(*decoder_, decoder_position_, frame_number, frame)) {
+    return false;
+  }
+
+  service_->put_in_cache(frame_number, frame);
+  return true;
+}
+
+
+FrameService& FrameService::Reader::service()
+{
+  return *service_;
+}
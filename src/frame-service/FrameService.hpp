@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MDL_FRAME_SERVICE_H
+#define MDL_FRAME_SERVICE_H
+
+#include <string>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+
+#include <opencv2/core.hpp>
+
+#include "opencv-logo-finder/VideoSource.hpp"
+
+#include "FrameCache.hpp"
+
+
+namespace mdl {
+  /**
+   * Decodes the frames of a video for everyone that reads it in the
+   * same process: the frames displayed while editing, and those read
+   * by logo finders. Decoded frames are kept in a cache shared by
+   * all, so a frame decoded for one is not decoded again for
+   * another.
+   *
+   * Frames for display have priority: readers wait to decode while
+   * a frame for display is being decoded. Each reader decodes with a
+   * decoder of its own, so that readers going through different
+   * parts of the video don't make each other seek.
+   */
+  class FrameService
+  {
+  public:
+    /**
+     * The service for file, created if nobody is using it. Throws
+     * VideoNotOpenedException
+     */
+    static std::shared_ptr<FrameService> for_file(const std::string& file);
+
+    /** Throws VideoNotOpenedException */
+    explicit FrameService(const std::string& file);
+
+    FrameService(const FrameService&) = delete;
+    FrameService& operator=(const FrameService&) = delete;
+
+    int get_frame_width() const;
+    int get_frame_height() const;
+    int get_number_of_frames() const;
+    double get_fps() const;
+
+    /**
+     * A frame to be displayed, as BGR. It is shared with the cache,
+     * and must not be modified. Throws FrameNotAvailableException
+     */
+    cv::Mat get_frame(int frame_number);
+
+
+    /** Reads frames in bulk, with lower priority than display */
+    class Reader
+    {
+    public:
+      explicit Reader(std::shared_ptr<FrameService> service);
+
+      /**
+       * Returns false if the frame could not be decoded. The frame is
+       * shared with the cache, and must not be modified.
+       */
+      bool read(int frame_number, cv::Mat& frame);
+
+      FrameService& service();
+
+    private:
+      std::shared_ptr<FrameService> service_;
+      // Only opened when a frame is not in the cache
+      std::unique_ptr<opencv::VideoSource> decoder_;
+      int decoder_position_;
+    };
+
+  private:
+    static const std::size_t CACHE_BYTES_ = 512 * 1024 * 1024;
+    // Decoding up to this many frames is faster than seeking
+    static const int MAX_SKIPPED_FRAMES_ = 50;
+
+    std::string file_;
+
+    // Only used for frames to be displayed
+    std::mutex decoder_mutex_;
+    std::unique_ptr<opencv::VideoSource> decoder_;
+    int decoder_position_;
+
+    int frame_width_;
+    int frame_height_;
+    int number_of_frames_;
+    double fps_;
+
+    // Protects the cache and display_requests_
+    std::mutex cache_mutex_;
+    FrameCache<cv::Mat> cache_;
+    int display_requests_;
+    std::condition_variable display_done_;
+
+
+    bool find_in_cache(int frame_number, cv::Mat& frame);
+    void put_in_cache(int frame_number, const cv::Mat& frame);
+    void wait_for_display();
+
+    static bool decode(opencv::VideoSource& decoder, int& position,
+                       int frame_number, cv::Mat& frame);
+  };
+}
+
+#endif // MDL_FRAME_SERVICE_H
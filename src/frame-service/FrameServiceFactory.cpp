@@ -21,20 +21,23 @@
 
 #include <glibmm/refptr.h>
 
-#include <opencv2/videoio.hpp>
-
-#include "gui/common/Exceptions.hpp"
 #include "gui/common/FrameProvider.hpp"
+#include "opencv-logo-finder/VideoSource.hpp"
 
-#include "OpenCVFrameProvider.hpp"
+#include "FrameService.hpp"
+#include "ServiceFrameProvider.hpp"
+#include "ServiceVideoSource.hpp"
 
 
 Glib::RefPtr<mdl::FrameProvider> mdl::create_frame_provider(const std::string& movie_filename)
 {
-  std::unique_ptr<cv::VideoCapture> video(new cv::VideoCapture(movie_filename));
-  if (!video->isOpened()) {
-    throw mdl::VideoNotOpenedException();
-  }
+  return Glib::RefPtr<mdl::FrameProvider>(
+    new mdl::ServiceFrameProvider(mdl::FrameService::for_file(movie_filename)));
+}
 
-  return Glib::RefPtr<mdl::FrameProvider>(new mdl::opencv::OpenCVFrameProvider(std::move(video)));
+
+std::unique_ptr<mdl::opencv::VideoSource> mdl::opencv::create_video_source(const std::string& file)
+{
+  return std::unique_ptr<mdl::opencv::VideoSource>(
+    new mdl::ServiceVideoSource(mdl::FrameService::for_file(file)));
 }
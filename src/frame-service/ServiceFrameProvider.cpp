@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <memory>
+
+#include <glibmm/refptr.h>
+#include <gdkmm/pixbuf.h>
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include "FrameService.hpp"
+#include "ServiceFrameProvider.hpp"
+
+using namespace mdl;
+
+
+ServiceFrameProvider::ServiceFrameProvider(std::shared_ptr<FrameService> service)
+  : FrameProvider()
+  , service_(service)
+{
+}
+
+
+Glib::RefPtr<Gdk::Pixbuf> ServiceFrameProvider::get_frame(int frame_number)
+{
+  cv::Mat bgr_frame = service_->get_frame(frame_number);
+
+  // The frame is converted straight into the pixbuf memory
+  auto pixbuf = Gdk::Pixbuf::create(Gdk::COLORSPACE_RGB, false, 8, bgr_frame.cols, bgr_frame.rows);
+  cv::Mat rgb_frame(bgr_frame.rows, bgr_frame.cols, CV_8UC3, pixbuf->get_pixels(), pixbuf->get_rowstride());
+  cv::cvtColor(bgr_frame, rgb_frame, cv::COLOR_BGR2RGB);
+  return pixbuf;
+}
+
+
+int ServiceFrameProvider::get_frame_width()
+{
+  return service_->get_frame_width();
+}
+
+
+int ServiceFrameProvider::get_frame_height()
+{
+  return service_->get_frame_height();
+}
+
+
+int ServiceFrameProvider::get_number_of_frames()
+{
+  return service_->get_number_of_frames();
+}
+
+
+double ServiceFrameProvider::get_fps()
+{
+  return service_->get_fps();
+}
+
+
+long ServiceFrameProvider::get_duration()
+{
+  return get_number_of_frames() / get_fps() * 1000;
+}
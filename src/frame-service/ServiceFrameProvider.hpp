@@ -16,26 +16,30 @@
  * You should have received a copy of the GNU General Public License
  * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
  */
-#ifndef MDL_OPENCV_OPENCV_FRAME_PROVIDER_H
-#define MDL_OPENCV_OPENCV_FRAME_PROVIDER_H
+#ifndef MDL_SERVICE_FRAME_PROVIDER_H
+#define MDL_SERVICE_FRAME_PROVIDER_H
 
-#include <string>
 #include <memory>
 
 #include <glibmm/objectbase.h>
 #include <glibmm/refptr.h>
 #include <gdkmm/pixbuf.h>
 
-#include <opencv2/videoio.hpp>
-
 #include "gui/common/FrameProvider.hpp"
 
+#include "FrameService.hpp"
+
 
-namespace mdl { namespace opencv {
-  class OpenCVFrameProvider : public FrameProvider
+namespace mdl {
+  /**
+   * Provides the frames displayed while editing from the frame
+   * service. Holding the provider keeps the service, and its cache,
+   * alive for the logo finders of the project.
+   */
+  class ServiceFrameProvider : public FrameProvider
   {
   public:
-    OpenCVFrameProvider(std::unique_ptr<cv::VideoCapture> video);
+    ServiceFrameProvider(std::shared_ptr<FrameService> service);
 
     Glib::RefPtr<Gdk::Pixbuf> get_frame(int frame_number) override;
 
@@ -46,12 +50,8 @@ namespace mdl { namespace opencv {
     long get_duration() override;
 
   private:
-    std::unique_ptr<cv::VideoCapture> video_;
-    int current_frame_;
-    // We keep a structure for the frame data in order to avoid reallocating space every time a frame is requested.
-    cv::Mat frame_;
+    std::shared_ptr<FrameService> service_;
   };
-} }
-
+}
 
-#endif // MDL_OPENCV_OPENCV_FRAME_PROVIDER_H
+#endif // MDL_SERVICE_FRAME_PROVIDER_H
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <memory>
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include "FrameService.hpp"
+#include "ServiceVideoSource.hpp"
+
+using namespace mdl;
+
+
+ServiceVideoSource::ServiceVideoSource(std::shared_ptr<FrameService> service)
+  : reader_(service)
+  , next_frame_(0)
+  , current_frame_(-1)
+{
+}
+
+
+void ServiceVideoSource::seek(int frame_number)
+{
+  next_frame_ = frame_number;
+}
+
+
+bool ServiceVideoSource::grab()
+{
+  if (next_frame_ >= get_number_of_frames()) {
+    return false;
+  }
+
+  current_frame_ = next_frame_++;
+  frame_.release();
+  return true;
+}
+
+
+bool ServiceVideoSource::retrieve(cv::Mat& frame)
+{
+  if (!read_current_frame()) {
+    return false;
+  }
+
+  frame = frame_;
+  return true;
+}
+
+
+bool ServiceVideoSource::retrieve_luma(cv::Mat& luma)
+{
+  if (!read_current_frame()) {
+    return false;
+  }
+
+  cv::cvtColor(frame_, luma_, cv::COLOR_BGR2GRAY);
+  luma = luma_;
+  return true;
+}
+
+
+bool ServiceVideoSource::read_current_frame()
+{
+  if (current_frame_ < 0) {
+    return false;
+  }
+  if (!frame_.empty()) {
+    return true;
+  }
+  return reader_.read(current_frame_, frame_);
+}
+
+
+int ServiceVideoSource::get_frame_width()
+{
+  return reader_.service().get_frame_width();
+}
+
+
+int ServiceVideoSource::get_frame_height()
+{
+  return reader_.service().get_frame_height();
+}
+
+
+int ServiceVideoSource::get_number_of_frames()
+{
+  return reader_.service().get_number_of_frames();
+}
+
+
+double ServiceVideoSource::get_fps()
+{
+  return reader_.service().get_fps();
+}
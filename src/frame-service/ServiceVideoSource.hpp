@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MDL_SERVICE_VIDEO_SOURCE_H
+#define MDL_SERVICE_VIDEO_SOURCE_H
+
+#include <memory>
+
+#include <opencv2/core.hpp>
+
+#include "opencv-logo-finder/VideoSource.hpp"
+
+#include "FrameService.hpp"
+
+
+namespace mdl {
+  /**
+   * Reads the frames for a logo finder from the frame service. Frames
+   * are only decoded when retrieved, so grab() is free.
+   */
+  class ServiceVideoSource : public opencv::VideoSource
+  {
+  public:
+    explicit ServiceVideoSource(std::shared_ptr<FrameService> service);
+
+    void seek(int frame_number) override;
+    bool grab() override;
+    /** The frame is shared with the cache, and must not be modified */
+    bool retrieve(cv::Mat& frame) override;
+    bool retrieve_luma(cv::Mat& luma) override;
+
+    int get_frame_width() override;
+    int get_frame_height() override;
+    int get_number_of_frames() override;
+    double get_fps() override;
+
+  private:
+    FrameService::Reader reader_;
+    int next_frame_;
+    int current_frame_;
+    // The last frame retrieved, if it is current_frame_
+    cv::Mat frame_;
+    cv::Mat luma_;
+
+    bool read_current_frame();
+  };
+}
+
+#endif // MDL_SERVICE_VIDEO_SOURCE_H
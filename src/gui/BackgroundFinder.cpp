@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <memory>
+#include <map>
+#include <thread>
+#include <algorithm>
+
+#include <glibmm/main.h>
+#include <glibmm/dispatcher.h>
+
+#include "filter-generator/Filters.hpp"
+#include "filter-generator/FilterList.hpp"
+
+#include "common/LogoFinder.hpp"
+
+#include "BackgroundFinder.hpp"
+#include "FilterListModel.hpp"
+
+using namespace mdl;
+
+
+BackgroundFinder::BackgroundFinder(const std::string& movie_file, int number_of_frames,
+                                   int frame_interval, bool verbose)
+  : movie_file_(movie_file)
+  , number_of_frames_(number_of_frames)
+  , frame_interval_(frame_interval)
+  , verbose_(verbose)
+  , model_(FilterListModel::create(suggestions_))
+  , position_(1)
+  , running_(false)
+  , restart_pending_(false)
+{
+  results_dispatcher_.connect(sigc::mem_fun(*this, &BackgroundFinder::on_results));
+  finished_dispatcher_.connect(sigc::mem_fun(*this, &BackgroundFinder::on_finished));
+}
+
+
+BackgroundFinder::~BackgroundFinder()
+{
+  restart_timeout_.disconnect();
+  stop();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+
+Glib::RefPtr<FilterListModel> BackgroundFinder::get_model()
+{
+  return model_;
+}
+
+
+void BackgroundFinder::set_position(int frame)
+{
+  position_ = frame;
+
+  stop();
+  restart_timeout_.disconnect();
+  restart_timeout_ = Glib::signal_timeout().connect(
+    sigc::mem_fun(*this, &BackgroundFinder::on_idle), IDLE_DELAY_MS_);
+}
+
+
+fg::FilterList::maybe_type BackgroundFinder::get_suggestion_for_frame(int frame) const
+{
+  auto suggestion = suggestions_.get_filter_for_frame(frame);
+  if (!suggestion) {
+    return boost::none;
+  }
+
+  // Suggestions don't cover all frames until the next one
+  auto searched = searched_.find(suggestion->first);
+  if (searched == searched_.end() || searched->second < frame) {
+    return boost::none;
+  }
+
+  return suggestion;
+}
+
+
+void BackgroundFinder::remove_suggestion(int start_frame)
+{
+  auto iter = model_->get_by_start_frame(start_frame);
+  if (iter) {
+    model_->remove(iter);
+  }
+}
+
+
+bool BackgroundFinder::on_idle()
+{
+  // The previous search was stopped when the position changed, but
+  // it may still be finishing its current step
+  if (running_) {
+    restart_pending_ = true;
+    return false;
+  }
+
+  int start_frame = next_unsearched_frame(position_);
+  if (start_frame <= number_of_frames_) {
+    start(start_frame);
+  }
+
+  return false;
+}
+
+
+void BackgroundFinder::start(int start_frame)
+{
+  finder_ = create_logo_finder(movie_file_, *this, verbose_);
+  finder_->set_start_frame(start_frame - 1);
+  finder_->set_end_frame(std::min(number_of_frames_, start_frame - 1 + LOOKAHEAD_FRAMES_));
+  finder_->set_frame_interval_min(frame_interval_);
+  finder_->set_extra_frames(0);
+
+  running_ = true;
+  thread_ = std::thread([this] {
+      finder_->find_logos();
+      finished_dispatcher_.emit();
+  });
+}
+
+
+void BackgroundFinder::stop()
+{
+  if (finder_) {
+    finder_->stop();
+  }
+}
+
+
+int BackgroundFinder::next_unsearched_frame(int frame) const
+{
+  while (true) {
+    auto i = searched_.upper_bound(frame);
+    if (i == searched_.begin()) {
+      return frame;
+    }
+
+    --i;
+    if (i->second < frame) {
+      return frame;
+    }
+    frame = i->second + 1;
+  }
+}
+
+
+void BackgroundFinder::success(const LogoFinderResult& result)
+{
+  results_.push(Result{result.start_frame + 1, result.end_frame + 1,
+                       fg::filter_ptr(new fg::DelogoFilter(result.x, result.y,
+                                                           result.width, result.height))});
+  results_dispatcher_.emit();
+}
+
+
+void BackgroundFinder::failure(int start_frame, int end_frame)
+{
+  results_.push(Result{start_frame + 1, end_frame + 1, nullptr});
+  results_dispatcher_.emit();
+}
+
+
+void BackgroundFinder::on_results()
+{
+  Result result;
+  while (results_.pop(result)) {
+    searched_[result.start_frame] = result.end_frame;
+    if (result.filter) {
+      model_->insert(result.start_frame, result.filter);
+    }
+  }
+}
+
+
+void BackgroundFinder::on_finished()
+{
+  // The thread has already returned from the search, so this doesn't
+  // block
+  thread_.join();
+  running_ = false;
+
+  // Results emitted just before finishing may not have been handled
+  on_results();
+
+  if (restart_pending_) {
+    restart_pending_ = false;
+    on_idle();
+  }
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MDL_BACKGROUND_FINDER_H
+#define MDL_BACKGROUND_FINDER_H
+
+#include <string>
+#include <memory>
+#include <map>
+#include <thread>
+
+#include <glibmm/dispatcher.h>
+
+#include "filter-generator/Filters.hpp"
+#include "filter-generator/FilterList.hpp"
+
+#include "common/LogoFinder.hpp"
+
+#include "FilterListModel.hpp"
+#include "SPSCQueue.hpp"
+
+
+namespace mdl {
+  /**
+   * Searches for logos in a thread while the user edits, ahead of the
+   * frame being displayed. The logos found go to a list of
+   * suggestions, not to the filters. The search stops whenever the
+   * displayed frame changes, so that it doesn't compete with the
+   * navigation, and starts again from the new position once the user
+   * stays on a frame for a while.
+   */
+  class BackgroundFinder : public LogoFinderCallback
+  {
+  public:
+    BackgroundFinder(const std::string& movie_file, int number_of_frames,
+                     int frame_interval, bool verbose);
+    ~BackgroundFinder();
+
+    BackgroundFinder(const BackgroundFinder&) = delete;
+    BackgroundFinder& operator=(const BackgroundFinder&) = delete;
+
+    Glib::RefPtr<FilterListModel> get_model();
+
+    /** Must be called whenever the displayed frame changes */
+    void set_position(int frame);
+
+    /** The suggestion applied to frame, if there is one */
+    fg::FilterList::maybe_type get_suggestion_for_frame(int frame) const;
+    void remove_suggestion(int start_frame);
+
+    void success(const LogoFinderResult& result) override;
+    void failure(int start_frame, int end_frame) override;
+
+  private:
+    /** Frames are 1-based. filter is null if no logo was found */
+    struct Result
+    {
+      int start_frame;
+      int end_frame;
+      fg::filter_ptr filter;
+    };
+
+    static const int IDLE_DELAY_MS_ = 1000;
+    static const int LOOKAHEAD_FRAMES_ = 9000;
+
+    std::string movie_file_;
+    int number_of_frames_;
+    int frame_interval_;
+    bool verbose_;
+
+    fg::FilterList suggestions_;
+    Glib::RefPtr<FilterListModel> model_;
+    /** Last frame of each range already searched, by its first frame */
+    std::map<int, int> searched_;
+
+    int position_;
+    sigc::connection restart_timeout_;
+
+    std::shared_ptr<LogoFinder> finder_;
+    std::thread thread_;
+    /** Whether thread_ is searching, or has finished and not been joined */
+    bool running_;
+    /** Whether to search again once the running search finishes */
+    bool restart_pending_;
+    SPSCQueue<Result> results_;
+    Glib::Dispatcher results_dispatcher_;
+    Glib::Dispatcher finished_dispatcher_;
+
+
+    bool on_idle();
+    void start(int start_frame);
+    void stop();
+    int next_unsearched_frame(int frame) const;
+
+    void on_results();
+    void on_finished();
+  };
+}
+
+#endif // MDL_BACKGROUND_FINDER_H
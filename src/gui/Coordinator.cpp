@@ -42,15 +42,28 @@ Coordinator::Coordinator(Gtk::Window& parent_window,
   , parent_window_(parent_window)
   , frame_navigator_(nullptr)
   , frame_view_(nullptr)
+  , current_frame_(0)
   , number_of_frames_(number_of_frames)
   , panel_factory_(number_of_frames, frame_width, frame_height)
   , current_filter_panel_(nullptr)
   , current_filter_(nullptr)
   , scroll_filter_(false) // Will be changed in set_frame_navigator
+  , rectangle_update_pending_(false)
+  , tick_callback_id_(0)
+  , committing_panel_edit_(false)
 {
 }
 
 
+Coordinator::~Coordinator()
+{
+  if (tick_callback_id_) {
+    gtk_widget_remove_tick_callback(GTK_WIDGET(frame_view_->gobj()), tick_callback_id_);
+  }
+  edit_timeout_.disconnect();
+}
+
+
 void Coordinator::set_undo_buttons(Gtk::Widget* btn_undo, Gtk::Widget* btn_redo)
 {
   undo_manager_.set_undo_buttons(btn_undo, btn_redo);
@@ -148,14 +161,36 @@ int Coordinator::get_current_frame()
 }
 
 
+/**
+ * Adds a filter as an action that can be undone, replacing the filter
+ * starting at the same frame if there is one
+ */
+void Coordinator::add_filter(int start_frame, fg::filter_ptr filter)
+{
+  finish_rectangle_edit();
+
+  edit_action_ptr action;
+  auto iter = filter_model_->get_by_start_frame(start_frame);
+  if (iter) {
+    fg::filter_ptr old_filter = (*iter)[filter_model_->columns.filter];
+    action = edit_action_ptr(new UpdateFilterAction(start_frame, old_filter, filter));
+  } else {
+    action = edit_action_ptr(new AddFilterAction(start_frame, filter));
+  }
+  undo_manager_.execute_action(action);
+}
+
+
 void Coordinator::on_undo()
 {
+  finish_rectangle_edit();
   undo_manager_.undo_last_action();
 }
 
 
 void Coordinator::on_redo()
 {
+  finish_rectangle_edit();
   undo_manager_.redo_last_action();
 }
 
@@ -168,6 +203,10 @@ void Coordinator::on_filter_selected(int start_frame)
 
 void Coordinator::on_frame_changed(int new_frame)
 {
+  if (new_frame != current_frame_) {
+    finish_rectangle_edit();
+  }
+
   auto iter = filter_model_->get_for_frame(new_frame);
 
   if (iter && (*iter)[filter_model_->columns.start_frame] == new_frame) {
@@ -177,6 +216,7 @@ void Coordinator::on_frame_changed(int new_frame)
   }
 
   change_displayed_filter(iter);
+  frame_navigator_->set_preview_filter(iter ? current_filter_ : nullptr);
 
   current_frame_ = new_frame;
 }
@@ -214,7 +254,7 @@ void Coordinator::change_displayed_filter(const FilterListModel::iterator& iter)
   current_filter_ = filter;
   current_filter_start_frame_ = start_frame;
 
-  update_displayed_panel(filter->type(), panel_factory_.create(start_frame, filter));
+  update_displayed_panel(filter->type(), panel_factory_.get_panel(start_frame, filter));
 
   auto rect = current_filter_panel_->get_rectangle();
   if (rect) {
@@ -230,12 +270,18 @@ void Coordinator::change_displayed_filter(const FilterListModel::iterator& iter)
 
 void Coordinator::update_displayed_panel(fg::FilterType type, FilterPanel* panel)
 {
-  current_filter_panel_ = Gtk::manage(panel);
-
   on_filter_type_changed_.block();
-  filter_list_->set_filter(type, current_filter_panel_);
+  filter_list_->set_filter(type, panel);
   on_filter_type_changed_.block(false);
 
+  // Panels are reused, so they are only connected when they change
+  if (panel == current_filter_panel_) {
+    return;
+  }
+  current_filter_panel_ = panel;
+
+  on_panel_rectangle_changed_.disconnect();
+  on_start_frame_changed_.disconnect();
   on_panel_rectangle_changed_ = current_filter_panel_->signal_rectangle_changed().connect(
     sigc::mem_fun(*this, &Coordinator::on_panel_rectangle_changed));
   on_start_frame_changed_ = current_filter_panel_->signal_start_frame_changed().connect(
@@ -252,6 +298,8 @@ bool Coordinator::displaying_filter_start_frame()
 
 void Coordinator::on_filter_type_changed(fg::FilterType new_type)
 {
+  finish_rectangle_edit();
+
   if (!current_filter_) {
     return;
   }
@@ -269,6 +317,8 @@ void Coordinator::on_filter_type_changed(fg::FilterType new_type)
 
 void Coordinator::on_frame_rectangle_changed(Rectangle rect)
 {
+  finish_rectangle_edit();
+
   if (!current_filter_panel_) {
     create_new_filter_panel();
   }
@@ -281,13 +331,30 @@ void Coordinator::on_frame_rectangle_changed(Rectangle rect)
 }
 
 
+/**
+ * While a value is being adjusted in the panel the rectangle changes
+ * many times in a row. The changes are merged into a single action,
+ * and the filter is updated at most once per frame drawn.
+ */
 void Coordinator::on_panel_rectangle_changed(Rectangle rect)
 {
   on_frame_rectangle_changed_.block();
   frame_view_->show_rectangle(rect);
   on_frame_rectangle_changed_.block(false);
 
-  update_filter_for_current_frame();
+  if (!undo_manager_.in_transaction()) {
+    undo_manager_.begin_transaction();
+  }
+  edit_timeout_.disconnect();
+  edit_timeout_ = Glib::signal_timeout().connect(
+    sigc::mem_fun(*this, &Coordinator::on_edit_idle), EDIT_IDLE_MS_);
+
+  if (displaying_filter_start_frame()) {
+    schedule_rectangle_update();
+  } else {
+    // Adding a filter changes the displayed filter, so it isn't delayed
+    update_filter_for_current_frame();
+  }
 }
 
 
@@ -326,8 +393,63 @@ void Coordinator::add_new_filter_for_current_frame()
 }
 
 
+void Coordinator::schedule_rectangle_update()
+{
+  rectangle_update_pending_ = true;
+  if (!tick_callback_id_) {
+    tick_callback_id_ = gtk_widget_add_tick_callback(GTK_WIDGET(frame_view_->gobj()),
+                                                     &Coordinator::on_tick, this, nullptr);
+  }
+}
+
+
+gboolean Coordinator::on_tick(GtkWidget* widget, GdkFrameClock* clock, gpointer coordinator)
+{
+  Coordinator* self = static_cast<Coordinator*>(coordinator);
+  self->tick_callback_id_ = 0;
+  self->flush_rectangle_update();
+  return G_SOURCE_REMOVE;
+}
+
+
+void Coordinator::flush_rectangle_update()
+{
+  if (!rectangle_update_pending_) {
+    return;
+  }
+
+  rectangle_update_pending_ = false;
+  committing_panel_edit_ = true;
+  update_filter_for_current_frame();
+  committing_panel_edit_ = false;
+}
+
+
+bool Coordinator::on_edit_idle()
+{
+  finish_rectangle_edit();
+  return false;
+}
+
+
+/** Must be called before anything else changes the filters */
+void Coordinator::finish_rectangle_edit()
+{
+  if (tick_callback_id_) {
+    gtk_widget_remove_tick_callback(GTK_WIDGET(frame_view_->gobj()), tick_callback_id_);
+    tick_callback_id_ = 0;
+  }
+  flush_rectangle_update();
+
+  edit_timeout_.disconnect();
+  undo_manager_.end_transaction();
+}
+
+
 void Coordinator::on_start_frame_changed(int start_frame)
 {
+  finish_rectangle_edit();
+
   if (!confirm_overwrite_by_start_frame_change(start_frame)) {
     set_start_frame_in_filter_panel(current_filter_start_frame_);
     return;
@@ -372,12 +494,14 @@ bool Coordinator::confirm_overwrite_by_start_frame_change(int start_frame)
 void Coordinator::create_new_filter_panel()
 {
   fg::FilterType filter_type = filter_list_->get_selected_type();
-  update_displayed_panel(filter_type, panel_factory_.create(current_frame_, filter_type));
+  update_displayed_panel(filter_type, panel_factory_.get_panel(current_frame_, filter_type));
 }
 
 
 void Coordinator::on_remove_filter()
 {
+  finish_rectangle_edit();
+
   auto iter = filter_list_->get_selected();
   fg::filter_ptr filter = (*iter)[filter_model_->columns.filter];
 
@@ -409,6 +533,15 @@ void Coordinator::update_filter(int start_frame, fg::filter_ptr filter)
   auto iter = filter_model_->get_by_start_frame(start_frame);
   (*iter)[filter_model_->columns.filter] = filter;
 
+  // The panel being edited already shows the filter, and must stay
+  // in place so that the edit can go on
+  if (committing_panel_edit_) {
+    current_filter_ = filter;
+    frame_navigator_->set_preview_filter(filter);
+    frame_navigator_->update_preview();
+    return;
+  }
+
   bool saved_scroll_to_filter = scroll_filter_;
   scroll_filter_ = false;
   frame_navigator_->change_displayed_frame(start_frame);
@@ -433,6 +566,8 @@ void Coordinator::change_start_frame(int old_start_frame, int new_start_frame)
 
 void Coordinator::on_shift()
 {
+  finish_rectangle_edit();
+
   ShiftFramesWindow* window = ShiftFramesWindow::create(filter_model_, number_of_frames_, current_frame_);
   window->set_transient_for(parent_window_);
 
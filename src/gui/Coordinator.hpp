@@ -37,6 +37,7 @@ namespace mdl {
   public:
     Coordinator(Gtk::Window& parent_window,
                 int number_of_frames, int frame_width, int frame_height);
+    ~Coordinator();
 
     void set_undo_buttons(Gtk::Widget* btn_undo, Gtk::Widget* btn_redo);
     void set_filter_list(FilterList* filter_list);
@@ -49,10 +50,15 @@ namespace mdl {
 
     int get_current_frame();
 
+    void add_filter(int start_frame, fg::filter_ptr filter);
+
     void on_undo();
     void on_redo();
 
   private:
+    // A rectangle edit in the panel ends when it stops changing for this long
+    static const int EDIT_IDLE_MS_ = 500;
+
     UndoManager undo_manager_;
 
     Gtk::Window& parent_window_;
@@ -71,6 +77,11 @@ namespace mdl {
     fg::filter_ptr current_filter_;
     bool scroll_filter_;
 
+    bool rectangle_update_pending_;
+    guint tick_callback_id_;
+    sigc::connection edit_timeout_;
+    bool committing_panel_edit_;
+
 
     sigc::connection on_filter_selected_;
     void on_filter_selected(int start_frame);
@@ -95,6 +106,12 @@ namespace mdl {
     void add_new_filter_for_current_frame();
     void update_current_filter();
 
+    void schedule_rectangle_update();
+    static gboolean on_tick(GtkWidget* widget, GdkFrameClock* clock, gpointer coordinator);
+    void flush_rectangle_update();
+    bool on_edit_idle();
+    void finish_rectangle_edit();
+
     sigc::connection on_start_frame_changed_;
     void on_start_frame_changed(int start_frame);
     bool confirm_overwrite_by_start_frame_change(int start_frame);
@@ -17,6 +17,7 @@
  * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <utility>
+#include <typeinfo>
 
 #include <glibmm.h>
 #include <glibmm/i18n.h>
@@ -54,6 +55,23 @@ std::string AddFilterAction::get_description() const
 }
 
 
+/** Later changes to the filter added become part of adding it */
+bool AddFilterAction::merge(const EditAction& next)
+{
+  if (typeid(next) != typeid(UpdateFilterAction)) {
+    return false;
+  }
+
+  auto& update = static_cast<const UpdateFilterAction&>(next);
+  if (update.get_start_frame() != start_frame_) {
+    return false;
+  }
+
+  filter_ = update.get_new_filter();
+  return true;
+}
+
+
 UpdateFilterAction::UpdateFilterAction(int start_frame, fg::filter_ptr old_filter, fg::filter_ptr new_filter)
   : start_frame_(start_frame)
   , old_filter_(old_filter)
@@ -80,6 +98,34 @@ std::string UpdateFilterAction::get_description() const
 }
 
 
+bool UpdateFilterAction::merge(const EditAction& next)
+{
+  if (typeid(next) != typeid(UpdateFilterAction)) {
+    return false;
+  }
+
+  auto& update = static_cast<const UpdateFilterAction&>(next);
+  if (update.start_frame_ != start_frame_) {
+    return false;
+  }
+
+  new_filter_ = update.new_filter_;
+  return true;
+}
+
+
+int UpdateFilterAction::get_start_frame() const
+{
+  return start_frame_;
+}
+
+
+fg::filter_ptr UpdateFilterAction::get_new_filter() const
+{
+  return new_filter_;
+}
+
+
 ChangeFilterTypeAction::ChangeFilterTypeAction(int start_frame, fg::filter_ptr old_filter, fg::filter_ptr new_filter)
   : UpdateFilterAction(start_frame, old_filter, new_filter)
 {
@@ -38,6 +38,13 @@ namespace mdl {
     virtual void execute(Coordinator& coordinator) = 0;
     virtual void undo(Coordinator& coordinator) = 0;
     virtual std::string get_description() const = 0;
+
+    /**
+     * Merges next, executed right after this action, into this
+     * one, so that both are undone together. Returns false if they
+     * can't be merged.
+     */
+    virtual bool merge(const EditAction& next) { return false; }
   };
 
 
@@ -52,6 +59,7 @@ namespace mdl {
     void execute(Coordinator& coordinator) override;
     void undo(Coordinator& coordinator) override;
     std::string get_description() const override;
+    bool merge(const EditAction& next) override;
 
   private:
     int start_frame_;
@@ -67,6 +75,10 @@ namespace mdl {
     void execute(Coordinator& coordinator) override;
     void undo(Coordinator& coordinator) override;
     std::string get_description() const override;
+    bool merge(const EditAction& next) override;
+
+    int get_start_frame() const;
+    fg::filter_ptr get_new_filter() const;
 
   protected:
     int start_frame_;
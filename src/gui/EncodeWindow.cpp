@@ -16,6 +16,8 @@
  * You should have received a copy of the GNU General Public License
  * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
  */
+#include <cerrno>
+#include <algorithm>
 #include <memory>
 #include <string>
 
@@ -27,6 +29,7 @@
 #include "filter-generator/FilterData.hpp"
 #include "filter-generator/RegularScriptGenerator.hpp"
 #include "filter-generator/FuzzyScriptGenerator.hpp"
+#include "encoder/SegmentedEncode.hpp"
 
 #include "common/Exceptions.hpp"
 #include "ETRProgressBar.hpp"
@@ -59,6 +62,7 @@ EncodeWindow::EncodeWindow(BaseObjectType* cobject,
   , filter_data_(std::move(filter_data))
   , frame_width_(frame_width)
   , frame_height_(frame_height)
+  , total_frames_(total_frames)
   , fps_(fps)
 
   , txt_file_(nullptr)
@@ -66,6 +70,7 @@ EncodeWindow::EncodeWindow(BaseObjectType* cobject,
   , cmb_preset_(nullptr)
   , chk_fuzzy_(nullptr)
   , txt_fuzzyness_(nullptr)
+  , chk_incremental_(nullptr)
   , box_progress_(nullptr)
   , lbl_status_(nullptr)
   , progress_bar_(nullptr)
@@ -129,6 +134,9 @@ void EncodeWindow::configure_widgets(const Glib::RefPtr<Gtk::Builder>& builder)
   builder->get_widget("box_scale", box_scale);
   widgets_to_disable_.push_back(box_scale);
 
+  builder->get_widget("chk_incremental", chk_incremental_);
+  widgets_to_disable_.push_back(chk_incremental_);
+
   Gtk::Button* btn_cmd_line = nullptr;
   builder->get_widget("btn_cmd_line", btn_cmd_line);
   btn_cmd_line->signal_clicked().connect(sigc::mem_fun(*this, &EncodeWindow::on_show_cmd_line));
@@ -184,6 +192,11 @@ void EncodeWindow::on_codec(FFmpegExecutor::Codec codec)
 void EncodeWindow::on_fuzzy_toggled()
 {
   txt_fuzzyness_->set_sensitive(chk_fuzzy_->get_active());
+  // Fuzzy filters can cross segment boundaries
+  chk_incremental_->set_sensitive(!chk_fuzzy_->get_active());
+  if (chk_fuzzy_->get_active()) {
+    chk_incremental_->set_active(false);
+  }
 }
 
 
@@ -210,7 +223,11 @@ void EncodeWindow::on_encode()
   ffmpeg_.set_output_file(file);
 
   try {
-    ffmpeg_.encode();
+    if (chk_incremental_->get_active()) {
+      ffmpeg_.encode_segments(get_segmented_encode(file));
+    } else {
+      ffmpeg_.encode();
+    }
 
     lbl_status_->set_text(_("Encoding in progress"));
     progress_bar_->reset();
@@ -296,24 +313,55 @@ bool EncodeWindow::check_file(const std::string& file)
 
 EncodeWindow::Generator EncodeWindow::get_generator()
 {
-  bool scale = chk_scale_->get_active();
-  fg::maybe_int scale_width  = scale
-    ? boost::make_optional(txt_scale_width_->get_value_as_int())
-    : boost::none;
-  fg::maybe_int scale_height = scale
-    ? boost::make_optional(txt_scale_height_->get_value_as_int())
-    : boost::none;
+  fg::maybe_int scale_width, scale_height;
+  get_scale(scale_width, scale_height);
 
-  Generator g;
+  std::shared_ptr<fg::RegularScriptGenerator> g;
   if (chk_fuzzy_->get_active()) {
     g = fg::FuzzyScriptGenerator::create(filter_data_->filter_list(), frame_width_, frame_height_, fps_, txt_fuzzyness_->get_value(), scale_width, scale_height);
   } else {
     g = fg::RegularScriptGenerator::create(filter_data_->filter_list(), frame_width_, frame_height_, fps_, scale_width, scale_height);
   }
+  g->set_cuts_first(true);
   return g;
 }
 
 
+void EncodeWindow::get_scale(fg::maybe_int& scale_width, fg::maybe_int& scale_height)
+{
+  bool scale = chk_scale_->get_active();
+  scale_width  = scale
+    ? boost::make_optional(txt_scale_width_->get_value_as_int())
+    : boost::none;
+  scale_height = scale
+    ? boost::make_optional(txt_scale_height_->get_value_as_int())
+    : boost::none;
+}
+
+
+/**
+ * The segments are kept in a directory named after the output file,
+ * so encoding to the same file again reuses them.
+ */
+std::shared_ptr<SegmentedEncode> EncodeWindow::get_segmented_encode(const std::string& file)
+{
+  std::string work_dir = file + ".segments";
+  if (g_mkdir_with_parents(work_dir.c_str(), 0755) == -1) {
+    throw ScriptGenerationException(Glib::strerror(errno));
+  }
+
+  fg::maybe_int scale_width, scale_height;
+  get_scale(scale_width, scale_height);
+
+  int segment_frames = std::max(1, (int) (SegmentedEncode::DEFAULT_SEGMENT_SECONDS_ * fps_));
+
+  return std::make_shared<SegmentedEncode>(filter_data_->filter_list(), ffmpeg_.command(),
+                                           frame_width_, frame_height_, fps_, total_frames_,
+                                           scale_width, scale_height, false,
+                                           work_dir, segment_frames);
+}
+
+
 void EncodeWindow::on_ffmpeg_finished(bool success, const std::string& error)
 {
   enable_widgets();
@@ -28,6 +28,8 @@
 #include "filter-generator/FilterData.hpp"
 #include "filter-generator/ScriptGenerator.hpp"
 
+#include "encoder/SegmentedEncode.hpp"
+
 #include "ETRProgressBar.hpp"
 #include "MultiDelogoAppWindow.hpp"
 #include "FFmpegExecutor.hpp"
@@ -53,6 +55,7 @@ namespace mdl {
     std::unique_ptr<fg::FilterData> filter_data_;
     int frame_width_;
     int frame_height_;
+    int total_frames_;
     double fps_;
     FFmpegExecutor::Codec codec_;
 
@@ -67,6 +70,8 @@ namespace mdl {
     Gtk::SpinButton* txt_scale_width_;
     Gtk::SpinButton* txt_scale_height_;
 
+    Gtk::CheckButton* chk_incremental_;
+
     Gtk::Box* box_progress_;
     Gtk::Label* lbl_status_;
     ETRProgressBar* progress_bar_;
@@ -90,6 +95,8 @@ namespace mdl {
     bool check_file(const std::string& file);
 
     Generator get_generator();
+    void get_scale(fg::maybe_int& scale_width, fg::maybe_int& scale_height);
+    std::shared_ptr<SegmentedEncode> get_segmented_encode(const std::string& file);
 
     void on_ffmpeg_finished(bool success, const std::string& error);
 
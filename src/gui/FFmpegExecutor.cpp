@@ -21,7 +21,7 @@
 #include <memory>
 #include <string>
 #include <fstream>
-#include <regex>
+#include <algorithm>
 
 #ifndef __MINGW32__
 #  include <sys/types.h>
@@ -30,12 +30,13 @@
 #  include <windows.h>
 #endif
 
-#include <boost/algorithm/string/predicate.hpp>
 #include <boost/algorithm/string/join.hpp>
 
 #include <glibmm.h>
 
 #include "filter-generator/ScriptGenerator.hpp"
+#include "encoder/FFmpegCommand.hpp"
+#include "encoder/SegmentedEncode.hpp"
 
 #include "common/Exceptions.hpp"
 #include "ETRProgressBar.hpp"
@@ -46,13 +47,13 @@ using namespace mdl;
 
 void FFmpegExecutor::set_generator(Generator generator)
 {
-  generator_ = generator;
+  command_.set_generator(generator);
 }
 
 
 void FFmpegExecutor::set_input_file(const std::string& input_file)
 {
-  input_file_ = input_file;
+  command_.set_input_file(input_file);
 }
 
 
@@ -64,29 +65,66 @@ void FFmpegExecutor::set_total_frames(int total_frames)
 
 void FFmpegExecutor::set_codec(Codec codec)
 {
-  codec_ = codec;
+  command_.set_codec(codec);
 }
 
 
 void FFmpegExecutor::set_quality(int quality)
 {
-  quality_ = quality;
+  command_.set_quality(quality);
 }
 
 
 void FFmpegExecutor::set_preset(const std::string& preset)
 {
-  preset_ = preset;
+  command_.set_preset(preset);
 }
 
 
 void FFmpegExecutor::set_output_file(const std::string& output_file)
 {
-  output_file_ = output_file;
+  command_.set_output_file(output_file);
+}
+
+
+const FFmpegCommand& FFmpegExecutor::command() const
+{
+  return command_;
 }
 
 
 void FFmpegExecutor::encode()
+{
+  create_tmp_filter_file();
+  generate_script(tmp_filter_file_);
+
+  total_frames_output_ = command_.generator()->resulting_frames(total_frames_);
+  frames_done_ = 0;
+  segmented_encode_.reset();
+  log_.clear();
+
+  std::vector<std::string> cmd_line = get_ffmpeg_cmd_line(tmp_filter_file_);
+
+  ffmpeg_timer_.start();
+  start_ffmpeg(cmd_line);
+}
+
+
+void FFmpegExecutor::encode_segments(std::shared_ptr<SegmentedEncode> segmented_encode)
+{
+  segmented_encode_ = segmented_encode;
+  total_frames_output_ = segmented_encode_->frames_to_encode();
+  frames_done_ = 0;
+  current_segment_ = 0;
+  log_.clear();
+
+  // The progress is for all the segments, so the time is too
+  ffmpeg_timer_.start();
+  start_next_segment();
+}
+
+
+void FFmpegExecutor::create_tmp_filter_file()
 {
   try {
     int tmp_fd = Glib::file_open_tmp(tmp_filter_file_, "mdlfilter");
@@ -94,14 +132,43 @@ void FFmpegExecutor::encode()
   } catch (Glib::FileError& e) {
     throw ScriptGenerationException(e.what());
   }
+}
 
-  generate_script(tmp_filter_file_);
 
-  total_frames_output_ = generator_->resulting_frames(total_frames_);
+/**
+ * Starts ffmpeg for the next segment that is not up to date, or
+ * to join the segments if all of them are.
+ */
+void FFmpegExecutor::start_next_segment()
+{
+  const auto& segments = segmented_encode_->segments();
+  while (current_segment_ < segments.size() && segments[current_segment_].up_to_date) {
+    ++current_segment_;
+  }
 
-  std::vector<std::string> cmd_line = get_ffmpeg_cmd_line(tmp_filter_file_);
+  if (current_segment_ == segments.size()) {
+    try {
+      segmented_encode_->write_concat_list();
+    } catch (SegmentedEncodeException& e) {
+      throw ScriptGenerationException(e.what());
+    }
+    // Joining doesn't encode, so all frames count as done
+    frames_done_ = total_frames_output_;
+    tmp_filter_file_.clear();
+    start_ffmpeg(segmented_encode_->get_concat_cmd_line());
+    return;
+  }
 
-  start_ffmpeg(cmd_line);
+  const SegmentedEncode::Segment& segment = segments[current_segment_];
+  create_tmp_filter_file();
+  std::ofstream file_stream(tmp_filter_file_);
+  if (!file_stream.is_open()) {
+    throw ScriptGenerationException(Glib::strerror(errno));
+  }
+  file_stream << segment.script;
+  file_stream.close();
+
+  start_ffmpeg(segmented_encode_->get_segment_cmd_line(segment, tmp_filter_file_));
 }
 
 
@@ -112,7 +179,7 @@ void FFmpegExecutor::generate_script(const std::string& output_script)
     throw ScriptGenerationException(Glib::strerror(errno));
   }
 
-  generator_->generate_ffmpeg_script(file_stream);
+  command_.generator()->generate_ffmpeg_script(file_stream);
   file_stream.close();
 }
 
@@ -142,67 +209,13 @@ const std::string& FFmpegExecutor::get_log() const
 
 std::vector<std::string> FFmpegExecutor::get_ffmpeg_cmd_line(const std::string& filter_file)
 {
-  std::string codec_name;
-  if (codec_ == Codec::H264) {
-    codec_name = "libx264";
-  } else if (codec_ == Codec::H265) {
-    codec_name = "libx265";
-  }
-
-  std::string quality_str = std::to_string(quality_);
-
-  std::vector<std::string> cmd_line;
-  cmd_line.push_back("ffmpeg");
-  cmd_line.push_back("-y");
-
-  cmd_line.push_back("-i"); cmd_line.push_back(input_file_);
-  cmd_line.push_back("-/filter_complex"); cmd_line.push_back(filter_file);
-
-  cmd_line.push_back("-map"); cmd_line.push_back("[out_v]");
-  cmd_line.push_back("-c:v"); cmd_line.push_back(codec_name);
-  cmd_line.push_back("-crf"); cmd_line.push_back(quality_str);
-
-  std::vector<std::string> audio_opts = get_audio_opts();
-  cmd_line.insert(cmd_line.end(), audio_opts.begin(), audio_opts.end());
-
-  cmd_line.push_back("-preset"); cmd_line.push_back(preset_);
-
-  if (is_mp4_output()) {
-    cmd_line.push_back("-movflags"); cmd_line.push_back("+faststart");
-  }
-
-  cmd_line.push_back(output_file_);
-
-  return cmd_line;
-}
-
-
-std::vector<std::string> FFmpegExecutor::get_audio_opts()
-{
-  std::vector<std::string> audio_opts;
-
-  if (generator_->affects_audio()) {
-    audio_opts.push_back("-map"); audio_opts.push_back("[out_a]");
-    audio_opts.push_back("-c:a"); audio_opts.push_back("aac");
-    audio_opts.push_back("-b:a"); audio_opts.push_back("192k");
-  } else {
-    audio_opts.push_back("-map"); audio_opts.push_back("0:a?");
-    audio_opts.push_back("-c:a"); audio_opts.push_back("copy");
-  }
-
-  return audio_opts;
-}
-
-
-bool FFmpegExecutor::is_mp4_output() const
-{
-  return boost::algorithm::ends_with(output_file_, ".mp4");
+  return command_.get_cmd_line(filter_file);
 }
 
 
 void FFmpegExecutor::start_ffmpeg(const std::vector<std::string>& cmd_line)
 {
-  log_ = boost::algorithm::join(cmd_line, " ");
+  log_ += boost::algorithm::join(cmd_line, " ");
   log_ += "\n\n";
 
   int ffmpeg_stderr_fd;
@@ -220,8 +233,6 @@ void FFmpegExecutor::start_ffmpeg(const std::vector<std::string>& cmd_line)
     throw FFmpegStartException(e.what());
   }
 
-  ffmpeg_timer_.start();
-
   Glib::signal_child_watch().connect(sigc::mem_fun(*this, &FFmpegExecutor::on_ffmpeg_finished),
                                      ffmpeg_pid_);
 
@@ -270,15 +281,15 @@ Progress FFmpegExecutor::get_progress(const std::string& ffmpeg_stats)
 {
   Progress p;
 
-  std::regex r("^frame=\\s+(\\d+)");
-  std::smatch matches;
-  if (!std::regex_search(ffmpeg_stats, matches, r)) {
+  int frames_encoded = FFmpegCommand::get_frames_encoded(ffmpeg_stats);
+  if (frames_encoded < 0) {
     p.percentage = -1;
     return p;
   }
 
-  int frames_encoded = std::stoi(matches[1].str());
-  p.percentage = (double) frames_encoded / total_frames_output_;
+  p.percentage = total_frames_output_ > 0
+    ? std::min(1.0, (double) (frames_done_ + frames_encoded) / total_frames_output_)
+    : 1.0;
 
   p.seconds_elapsed = ffmpeg_timer_.elapsed();
   p.calculate_time_remaining();
@@ -295,6 +306,20 @@ void FFmpegExecutor::on_ffmpeg_finished(Glib::Pid pid, int status)
 
   GError *error = nullptr;
   if (g_spawn_check_wait_status(status, &error)) {
+    if (segmented_encode_ && current_segment_ < segmented_encode_->segments().size()) {
+      try {
+        segmented_encode_->mark_encoded(current_segment_);
+        frames_done_ += segmented_encode_->segments()[current_segment_].output_frames;
+        ++current_segment_;
+        start_next_segment();
+      } catch (Exception& e) {
+        signal_finished_.emit(false, e.what());
+      } catch (SegmentedEncodeException& e) {
+        signal_finished_.emit(false, e.what());
+      }
+      return;
+    }
+
     signal_finished_.emit(true, "");
   } else {
     std::string message(error->message);
@@ -26,6 +26,8 @@
 #include <glibmm.h>
 
 #include "filter-generator/ScriptGenerator.hpp"
+#include "encoder/FFmpegCommand.hpp"
+#include "encoder/SegmentedEncode.hpp"
 
 #include "ETRProgressBar.hpp"
 
@@ -34,11 +36,11 @@ namespace mdl {
   class FFmpegExecutor
   {
   public:
-    enum class Codec { H264, H265 };
-    static const int H264_DEFAULT_CRF_ = 23;
-    static const int H265_DEFAULT_CRF_ = 28;
+    typedef FFmpegCommand::Codec Codec;
+    static const int H264_DEFAULT_CRF_ = FFmpegCommand::H264_DEFAULT_CRF_;
+    static const int H265_DEFAULT_CRF_ = FFmpegCommand::H265_DEFAULT_CRF_;
 
-    typedef std::shared_ptr<fg::ScriptGenerator> Generator;
+    typedef FFmpegCommand::Generator Generator;
 
   public:
     void set_generator(Generator generator);
@@ -51,7 +53,11 @@ namespace mdl {
     void set_preset(const std::string& preset);
     void set_output_file(const std::string& output_file);
 
+    const FFmpegCommand& command() const;
+
     void encode();
+    /** Encodes the segments that are not up to date, and then joins all of them */
+    void encode_segments(std::shared_ptr<SegmentedEncode> segmented_encode);
     void generate_script(const std::string& output_script);
     std::vector<std::string> get_ffmpeg_cmd_line(const std::string& filter_file);
 
@@ -67,18 +73,15 @@ namespace mdl {
     type_signal_finished signal_finished();
 
   private:
-    Generator generator_;
-
-    std::string input_file_;
+    FFmpegCommand command_;
     int total_frames_;
 
-    Codec codec_;
-    int quality_;
-    std::string preset_;
-    std::string output_file_;
-
     std::string tmp_filter_file_;
     int total_frames_output_;
+    /** Frames encoded by the previous jobs, when encoding segments */
+    int frames_done_ = 0;
+    std::shared_ptr<SegmentedEncode> segmented_encode_;
+    std::size_t current_segment_ = 0;
     Glib::Pid ffmpeg_pid_;
     Glib::RefPtr<Glib::IOChannel> ffmpeg_out_;
     sigc::connection ffmpeg_out_signal_;
@@ -90,10 +93,9 @@ namespace mdl {
     type_signal_finished signal_finished_;
 
 
-    bool is_mp4_output() const;
-    std::vector<std::string> get_audio_opts();
-
     void start_ffmpeg(const std::vector<std::string>& cmd_line);
+    void create_tmp_filter_file();
+    void start_next_segment();
 
     bool on_ffmpeg_output(Glib::IOCondition condition);
     Progress get_progress(const std::string& ffmpeg_stats);
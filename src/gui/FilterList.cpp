@@ -112,6 +112,10 @@ void FilterList::set_filter(fg::FilterType filter_type, Gtk::Widget* panel)
 {
   filter_type_->set(filter_type);
 
+  if (panel == current_panel_) {
+    return;
+  }
+
   if (current_panel_) {
     remove(*current_panel_);
   }
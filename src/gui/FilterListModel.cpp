@@ -17,6 +17,9 @@
  * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <utility>
+#include <vector>
+#include <iterator>
+#include <algorithm>
 #include <stdexcept>
 
 #include <glibmm/objectbase.h>
@@ -129,58 +132,83 @@ void FilterListModel::remove(const iterator& iter)
 }
 
 
+/**
+ * The filters are shifted in the list at once. The view is then told
+ * which rows were overwritten by the shifted filters, how the rows
+ * were reordered if the shifted filters passed others, and which
+ * start frames changed.
+ */
 std::pair<int, int> FilterListModel::shift_frames(int start, int end, int amount)
 {
-  iterator iter;
-  if (amount > 0) {
-    iter = get_for_frame(end);
-  } else {
-    iter = get_for_frame(start);
-    if (!iter) {
-      iter = children()[0];
-    }
-
-    if (iter && (*iter)[columns.start_frame] < start) {
-      ++iter;
+  std::vector<ShiftRow> unshifted;
+  std::vector<ShiftRow> shifted;
+  int position = 0;
+  for (const auto& filter: filter_list_) {
+    if (filter.first >= start && filter.first <= end) {
+      shifted.push_back({filter.first + amount, position, true});
+    } else {
+      unshifted.push_back({filter.first, position, false});
     }
+    ++position;
   }
 
-  if (!iter) {
+  if (shifted.empty()) {
     return std::make_pair(0, 0);
   }
 
-  auto path = get_path(iter);
-  int first_frame = (*iter)[columns.start_frame];
-  int last_frame;
-
-  int iter_start_frame = first_frame;
-  while (true) {
-    last_frame = iter_start_frame;
-    (*iter)[columns.start_frame] = iter_start_frame + amount;
-
-    if (amount > 0) {
-      if (!path.prev()) {
-        break;
-      }
-    } else {
-      path.next();
+  // Both are ordered by start frame
+  std::vector<int> overwritten;
+  std::vector<ShiftRow> kept;
+  auto s = shifted.begin();
+  for (const auto& row: unshifted) {
+    while (s != shifted.end() && s->start_frame < row.start_frame) {
+      ++s;
     }
-    iter = get_iter(path);
-    if (!iter) {
-      break;
+    if (s != shifted.end() && s->start_frame == row.start_frame) {
+      overwritten.push_back(row.old_position);
+    } else {
+      kept.push_back(row);
     }
+  }
 
-    iter_start_frame = (*iter)[columns.start_frame];
-    if (iter_start_frame < start || iter_start_frame > end) {
-      break;
-    }
+  std::pair<int, int> frames = filter_list_.shift(start, end, amount);
+  ++stamp_;
+
+  for (auto i = overwritten.rbegin(); i != overwritten.rend(); ++i) {
+    Path path;
+    path.push_back(*i);
+    row_deleted(path);
+  }
+
+  std::vector<ShiftRow> rows;
+  rows.reserve(kept.size() + shifted.size());
+  std::merge(kept.begin(), kept.end(), shifted.begin(), shifted.end(), std::back_inserter(rows),
+             [](const ShiftRow& r1, const ShiftRow& r2) {
+               return r1.start_frame < r2.start_frame;
+             });
+
+  std::vector<int> new_order;
+  new_order.reserve(rows.size());
+  bool reordered = false;
+  for (const auto& row: rows) {
+    int deleted_before = std::lower_bound(overwritten.begin(), overwritten.end(), row.old_position)
+      - overwritten.begin();
+    new_order.push_back(row.old_position - deleted_before);
+    reordered = reordered || new_order.back() != int(new_order.size()) - 1;
+  }
+  if (reordered) {
+    rows_reordered(Path(), new_order);
   }
 
-  if (amount > 0) {
-    return std::make_pair(last_frame, first_frame);
-  } else {
-    return std::make_pair(first_frame, last_frame);
+  for (std::size_t i = 0; i < rows.size(); ++i) {
+    if (rows[i].shifted) {
+      Path path;
+      path.push_back(i);
+      row_changed(path, get_iter(path));
+    }
   }
+
+  return frames;
 }
 
 
@@ -87,6 +87,14 @@ namespace mdl {
 
 
   private:
+    /** Where a row was and where it goes, in shift_frames() */
+    struct ShiftRow
+    {
+      int start_frame;
+      int old_position;
+      bool shifted;
+    };
+
     fg::FilterList& filter_list_;
     int stamp_;
 
@@ -16,6 +16,7 @@
  * You should have received a copy of the GNU General Public License
  * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
  */
+#include <map>
 #include <memory>
 
 #include <gtkmm.h>
@@ -89,3 +90,27 @@ FilterPanel* FilterPanelFactory::create(int start_frame, fg::FilterType type)
     return nullptr;
   }
 }
+
+
+FilterPanel* FilterPanelFactory::get_panel(int start_frame, fg::filter_ptr filter)
+{
+  auto& panel = panels_[filter->type()];
+  if (panel) {
+    panel->bind(start_frame, filter);
+  } else {
+    panel.reset(create(start_frame, filter));
+  }
+  return panel.get();
+}
+
+
+FilterPanel* FilterPanelFactory::get_panel(int start_frame, fg::FilterType type)
+{
+  auto& panel = panels_[type];
+  if (panel) {
+    panel->bind(start_frame, nullptr);
+  } else {
+    panel.reset(create(start_frame, type));
+  }
+  return panel.get();
+}
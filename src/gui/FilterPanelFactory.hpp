@@ -19,6 +19,9 @@
 #ifndef MDL_FILTER_PANEL_FACTORY_H
 #define MDL_FILTER_PANEL_FACTORY_H
 
+#include <map>
+#include <memory>
+
 #include <gtkmm.h>
 
 #include <boost/optional.hpp>
@@ -42,6 +45,12 @@ namespace mdl {
     virtual bool creates_filter() const;
     virtual fg::filter_ptr get_filter() const = 0;
     virtual void set_start_frame(int start_frame);
+    /**
+     * Shows the values of filter, or the defaults if it is null,
+     * without emitting any signal. Used to reuse the panel for
+     * another filter of the same type.
+     */
+    virtual void bind(int start_frame, fg::filter_ptr filter);
     virtual MaybeRectangle get_rectangle() const = 0;
     virtual void set_rectangle(const Rectangle& rect) = 0;
     virtual bool is_changed() const = 0;
@@ -60,6 +69,9 @@ namespace mdl {
     type_signal_start_frame_changed signal_start_frame_changed_;
     type_signal_rectangle_changed signal_rectangle_changed_;
 
+    // Set while bind() changes the values
+    bool binding_;
+
     void on_start_frame_change();
   };
 
@@ -72,10 +84,20 @@ namespace mdl {
     FilterPanel* create(int start_frame, fg::filter_ptr filter);
     FilterPanel* create(int start_frame, fg::FilterType type);
 
+    /**
+     * Like create(), but there is a single panel for each type, which
+     * is bound to the new values every time. The panels belong to the
+     * factory.
+     */
+    FilterPanel* get_panel(int start_frame, fg::filter_ptr filter);
+    FilterPanel* get_panel(int start_frame, fg::FilterType type);
+
   private:
     int max_frame_;
     int frame_width_;
     int frame_height_;
+
+    std::map<fg::FilterType, std::unique_ptr<FilterPanel>> panels_;
   };
 }
 
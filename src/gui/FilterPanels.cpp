@@ -16,6 +16,8 @@
  * You should have received a copy of the GNU General Public License
  * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
  */
+#include <memory>
+
 #include <gtkmm.h>
 #include <glibmm/i18n.h>
 
@@ -27,6 +29,7 @@ using namespace mdl;
 
 
 FilterPanel::FilterPanel(int start_frame, int max_frame)
+  : binding_(false)
 {
   set_orientation(Gtk::ORIENTATION_VERTICAL);
   set_row_spacing(6);
@@ -63,6 +66,14 @@ void FilterPanel::set_start_frame(int start_frame)
 }
 
 
+void FilterPanel::bind(int start_frame, fg::filter_ptr filter)
+{
+  binding_ = true;
+  txt_start_frame_.set_value(start_frame);
+  binding_ = false;
+}
+
+
 FilterPanel::type_signal_start_frame_changed FilterPanel::signal_start_frame_changed()
 {
   return signal_start_frame_changed_;
@@ -77,6 +88,9 @@ FilterPanel::type_signal_rectangle_changed FilterPanel::signal_rectangle_changed
 
 void FilterPanel::on_start_frame_change()
 {
+  if (binding_) {
+    return;
+  }
   signal_start_frame_changed_.emit(txt_start_frame_.get_value_as_int());
 }
 
@@ -216,6 +230,24 @@ void FilterPanelRectangular::add_widget(Gtk::Widget& widget,
 }
 
 
+void FilterPanelRectangular::bind(int start_frame, fg::filter_ptr filter)
+{
+  FilterPanel::bind(start_frame, filter);
+
+  auto rectangular = std::dynamic_pointer_cast<fg::RectangularFilter>(filter);
+  binding_ = true;
+  if (rectangular) {
+    set_rectangle({.x = double(rectangular->x()), .y = double(rectangular->y()),
+                   .width = double(rectangular->width()), .height = double(rectangular->height())});
+  } else {
+    set_rectangle({.x = 0, .y = 0, .width = 0, .height = 0});
+  }
+  binding_ = false;
+
+  is_changed_ = false;
+}
+
+
 FilterPanelRectangular::MaybeRectangle FilterPanelRectangular::get_rectangle() const
 {
   Rectangle rect = {.x = txt_x_.get_value(),
@@ -249,6 +281,10 @@ void FilterPanelRectangular::set_changed(bool changed)
 
 void FilterPanelRectangular::on_coordinate_change()
 {
+  if (binding_) {
+    return;
+  }
+
   is_changed_ = true;
   signal_rectangle_changed_.emit(*get_rectangle());
 }
@@ -85,6 +85,7 @@ namespace mdl {
                            int frame_width, int frame_height);
 
   public:
+    void bind(int start_frame, fg::filter_ptr filter) override;
     MaybeRectangle get_rectangle() const override;
     void set_rectangle(const Rectangle& rect) override;
     bool is_changed() const override;
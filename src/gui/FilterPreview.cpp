@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <tuple>
+#include <thread>
+#include <mutex>
+
+#include <gtkmm.h>
+
+#include "filter-generator/Filters.hpp"
+#include "opencv-renderer/FilterRenderer.hpp"
+
+#include "FilterPreview.hpp"
+
+using namespace mdl;
+
+
+FilterPreview::FilterPreview()
+  : waiting_(false)
+  , has_job_(false)
+  , has_result_(false)
+  , stop_(false)
+{
+  result_dispatcher_.connect(sigc::mem_fun(*this, &FilterPreview::on_result));
+  worker_thread_ = std::thread(&FilterPreview::work, this);
+}
+
+
+FilterPreview::~FilterPreview()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  job_available_.notify_one();
+  worker_thread_.join();
+}
+
+
+bool FilterPreview::can_preview(const fg::filter_ptr& filter)
+{
+  return filter
+    && (filter->type() == fg::FilterType::DELOGO
+        || filter->type() == fg::FilterType::DRAWBOX);
+}
+
+
+void FilterPreview::request(int frame_number, const Glib::RefPtr<Gdk::Pixbuf>& frame,
+                            const fg::filter_ptr& filter)
+{
+  Key key = get_key(frame_number, filter);
+  latest_key_ = key;
+
+  auto cached = cache_.find(key);
+  if (cached != cache_.end()) {
+    waiting_ = false;
+    signal_ready_.emit(frame_number, cached->second);
+    return;
+  }
+
+  waiting_ = true;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // A pending job that was not started yet is replaced
+    job_ = Job{.key = key, .pixbuf = frame->copy(), .filter = filter};
+    has_job_ = true;
+  }
+  job_available_.notify_one();
+}
+
+
+void FilterPreview::cancel()
+{
+  waiting_ = false;
+}
+
+
+FilterPreview::Key FilterPreview::get_key(int frame_number, const fg::filter_ptr& filter)
+{
+  auto rect = std::static_pointer_cast<fg::RectangularFilter>(filter);
+  return std::make_tuple(frame_number, filter->type(),
+                         rect->x(), rect->y(), rect->width(), rect->height());
+}
+
+
+void FilterPreview::add_to_cache(const Key& key, const Glib::RefPtr<Gdk::Pixbuf>& pixbuf)
+{
+  if (cache_.count(key)) {
+    return;
+  }
+
+  cache_[key] = pixbuf;
+  cache_order_.push_back(key);
+  if (cache_order_.size() > CACHE_SIZE_) {
+    cache_.erase(cache_order_.front());
+    cache_order_.pop_front();
+  }
+}
+
+
+void FilterPreview::work()
+{
+  while (true) {
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      job_available_.wait(lock, [this] { return has_job_ || stop_; });
+      if (stop_) {
+        return;
+      }
+      job = std::move(job_);
+      has_job_ = false;
+    }
+
+    opencv::ImageBuffer image{.data = job.pixbuf->get_pixels(),
+                              .width = job.pixbuf->get_width(),
+                              .height = job.pixbuf->get_height(),
+                              .stride = job.pixbuf->get_rowstride(),
+                              .channels = job.pixbuf->get_n_channels()};
+    opencv::FilterRenderer::render(*job.filter, image);
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      result_ = std::move(job);
+      has_result_ = true;
+    }
+    result_dispatcher_.emit();
+  }
+}
+
+
+void FilterPreview::on_result()
+{
+  Job result;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!has_result_) {
+      return;
+    }
+    result = std::move(result_);
+    has_result_ = false;
+  }
+
+  add_to_cache(result.key, result.pixbuf);
+
+  if (waiting_ && result.key == latest_key_) {
+    waiting_ = false;
+    signal_ready_.emit(std::get<0>(result.key), result.pixbuf);
+  }
+}
+
+
+FilterPreview::type_signal_ready FilterPreview::signal_ready()
+{
+  return signal_ready_;
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MDL_FILTER_PREVIEW_H
+#define MDL_FILTER_PREVIEW_H
+
+#include <map>
+#include <list>
+#include <tuple>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include <gtkmm.h>
+
+#include "filter-generator/Filters.hpp"
+
+
+namespace mdl {
+  /**
+   * Renders frames with a filter applied in a background thread.
+   * Results are cached by frame and filter rectangle, and only the
+   * result of the latest request is signaled.
+   */
+  class FilterPreview
+  {
+  public:
+    FilterPreview();
+    ~FilterPreview();
+
+    static bool can_preview(const fg::filter_ptr& filter);
+
+    void request(int frame_number, const Glib::RefPtr<Gdk::Pixbuf>& frame,
+                 const fg::filter_ptr& filter);
+    void cancel();
+
+    typedef sigc::signal<void, int, Glib::RefPtr<Gdk::Pixbuf>> type_signal_ready;
+    type_signal_ready signal_ready();
+
+  private:
+    static const std::size_t CACHE_SIZE_ = 64;
+
+    typedef std::tuple<int, fg::FilterType, int, int, int, int> Key;
+
+    struct Job
+    {
+      Key key;
+      Glib::RefPtr<Gdk::Pixbuf> pixbuf;
+      fg::filter_ptr filter;
+    };
+
+    std::map<Key, Glib::RefPtr<Gdk::Pixbuf>> cache_;
+    std::list<Key> cache_order_;
+    Key latest_key_;
+    bool waiting_;
+
+    std::thread worker_thread_;
+    std::mutex mutex_;
+    std::condition_variable job_available_;
+    bool has_job_;
+    Job job_;
+    bool has_result_;
+    Job result_;
+    bool stop_;
+    Glib::Dispatcher result_dispatcher_;
+
+    type_signal_ready signal_ready_;
+
+
+    static Key get_key(int frame_number, const fg::filter_ptr& filter);
+
+    void add_to_cache(const Key& key, const Glib::RefPtr<Gdk::Pixbuf>& pixbuf);
+
+    void work();
+    void on_result();
+  };
+}
+
+#endif // MDL_FILTER_PREVIEW_H
@@ -16,34 +16,46 @@
  * You should have received a copy of the GNU General Public License
  * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
  */
+#include <cstdio>
+#include <cerrno>
+#include <string>
 #include <memory>
+#include <map>
 #include <limits>
 #include <thread>
 #include <mutex>
+#include <utility>
 #include <algorithm>
+#include <iostream>
 
 #include <gtkmm.h>
 #include <glibmm/i18n.h>
 
+#include <boost/algorithm/string/join.hpp>
+
 #include "filter-generator/FilterData.hpp"
+#include "filter-generator/Filters.hpp"
 
-#include "opencv-logo-finder/FilterListAdapter.hpp"
+#include "common/LogoFinder.hpp"
 
 #include "FindLogosWindow.hpp"
 #include "ETRProgressBar.hpp"
+#include "FilterListModel.hpp"
+#include "ReviewRetrier.hpp"
 #include "Utils.hpp"
 
 using namespace mdl;
 
 
 FindLogosWindow* FindLogosWindow::create(fg::FilterData& filter_data,
+                                         const Glib::RefPtr<FilterListModel>& filter_model,
                                          int total_frames, int start_frame, int jump_size,
                                          bool verbose)
 {
   auto builder = Gtk::Builder::create_from_resource("/wt/multi-delogo/FindLogosWindow.ui");
   FindLogosWindow* window = nullptr;
   builder->get_widget_derived("find_logos_window", window,
-                              filter_data, total_frames, start_frame, jump_size,
+                              filter_data, filter_model, total_frames, start_frame, jump_size,
                               verbose);
   return window;
 }
@@ -52,11 +64,13 @@ FindLogosWindow* FindLogosWindow::create(fg::FilterData& filter_data,
 FindLogosWindow::FindLogosWindow(BaseObjectType* cobject,
                                  const Glib::RefPtr<Gtk::Builder>& builder,
                                  fg::FilterData& filter_data,
+                                 const Glib::RefPtr<FilterListModel>& filter_model,
                                  int total_frames, int start_frame, int jump_size,
                                  bool verbose)
   : MultiDelogoAppWindow(cobject)
 
   , filter_data_(filter_data)
+  , filter_model_(filter_model)
 
   , txt_initial_frame_(nullptr)
   , txt_final_frame_(nullptr)
@@ -68,15 +82,34 @@ FindLogosWindow::FindLogosWindow(BaseObjectType* cobject,
   , txt_min_logo_height_(nullptr)
   , txt_max_logo_height_(nullptr)
 
+  , chk_tracking_(nullptr)
+  , chk_scenes_(nullptr)
+  , chk_progressive_(nullptr)
+  , chk_pyramid_(nullptr)
+  , chk_luma_(nullptr)
+
   , progress_bar_(nullptr)
 
   , btn_find_logos_(nullptr)
+  , btn_retry_review_(nullptr)
+  , btn_forget_logos_(nullptr)
+
+  , total_frames_(total_frames)
 
   , worker_thread_(nullptr)
   , search_in_progress_(false)
-  , callback_(finder_progress_dispatcher_)
+  , verbose_(verbose)
+  , callback_(finder_progress_dispatcher_, found_filters_)
 {
-  logo_finder_ = create_logo_finder(filter_data_, callback_, verbose);
+  logo_finder_ = create_logo_finder(filter_data_.movie_file(), callback_, verbose);
+
+  // Logos found are kept for all projects, since videos from the same
+  // channel usually have the same logo
+  std::string data_dir = Glib::build_filename(Glib::get_user_data_dir(), "multi-delogo");
+  if (g_mkdir_with_parents(data_dir.c_str(), 0755) == 0) {
+    template_file_ = Glib::build_filename(data_dir, "logo-templates.yml");
+    logo_finder_->set_template_file(template_file_);
+  }
 
   configure_widgets(builder, total_frames, start_frame, jump_size);
 
@@ -121,6 +154,12 @@ void FindLogosWindow::configure_widgets(const Glib::RefPtr<Gtk::Builder>& builde
   configure_spin(*txt_max_logo_height_);
   txt_max_logo_height_->set_value(logo_finder_->get_max_logo_height());
 
+  builder->get_widget("chk_tracking", chk_tracking_);
+  builder->get_widget("chk_scenes", chk_scenes_);
+  builder->get_widget("chk_progressive", chk_progressive_);
+  builder->get_widget("chk_pyramid", chk_pyramid_);
+  builder->get_widget("chk_luma", chk_luma_);
+
   builder->get_widget_derived("progress_bar", progress_bar_);
 
   Gtk::Button* btn_close = nullptr;
@@ -129,6 +168,13 @@ void FindLogosWindow::configure_widgets(const Glib::RefPtr<Gtk::Builder>& builde
 
   builder->get_widget("btn_find_logos", btn_find_logos_);
   btn_find_logos_->signal_clicked().connect(sigc::mem_fun(*this, &FindLogosWindow::on_find_logos));
+
+  builder->get_widget("btn_retry_review", btn_retry_review_);
+  btn_retry_review_->signal_clicked().connect(sigc::mem_fun(*this, &FindLogosWindow::on_retry_review));
+
+  builder->get_widget("btn_forget_logos", btn_forget_logos_);
+  btn_forget_logos_->signal_clicked().connect(sigc::mem_fun(*this, &FindLogosWindow::on_forget_logos));
+  btn_forget_logos_->set_sensitive(Glib::file_test(template_file_, Glib::FILE_TEST_EXISTS));
 }
 
 
@@ -147,13 +193,7 @@ void FindLogosWindow::configure_spin(Gtk::SpinButton& spin, int max)
 
 void FindLogosWindow::on_find_logos()
 {
-  int min_frame_interval = txt_min_frame_interval_->get_value_as_int();
-  int max_frame_interval = txt_max_frame_interval_->get_value_as_int();
-  if (max_frame_interval < min_frame_interval) {
-    Gtk::MessageDialog dlg(*this,
-                           _("Invalid logo duration: maximum duration must be greater than or than the minimum duration"),
-                           false, Gtk::MESSAGE_ERROR);
-    dlg.run();
+  if (!check_frame_intervals()) {
     return;
   }
 
@@ -165,14 +205,10 @@ void FindLogosWindow::on_find_logos()
   int final_frame = txt_final_frame_->get_value_as_int() - 1;
 
   logo_finder_->set_start_frame(initial_frame);
-  logo_finder_->set_frame_interval_min(min_frame_interval);
-  logo_finder_->set_extra_frames(max_frame_interval - min_frame_interval);
-
-  logo_finder_->set_min_logo_width(txt_min_logo_width_->get_value_as_int());
-  logo_finder_->set_max_logo_width(txt_max_logo_width_->get_value_as_int());
-  logo_finder_->set_min_logo_height(txt_min_logo_height_->get_value_as_int());
-  logo_finder_->set_max_logo_height(txt_max_logo_height_->get_value_as_int());
+  logo_finder_->set_end_frame(final_frame + 1);
+  configure_finder(*logo_finder_);
 
+  remember_filters();
   search_in_progress_ = true;
   callback_.start(initial_frame, final_frame);
   worker_thread_ = new std::thread([this] {
@@ -181,6 +217,83 @@ void FindLogosWindow::on_find_logos()
       finder_finished_dispatcher_.emit();
   });
   btn_find_logos_->set_sensitive(false);
+  btn_retry_review_->set_sensitive(false);
+  btn_forget_logos_->set_sensitive(false);
+}
+
+
+bool FindLogosWindow::check_frame_intervals()
+{
+  int min_frame_interval = txt_min_frame_interval_->get_value_as_int();
+  int max_frame_interval = txt_max_frame_interval_->get_value_as_int();
+  if (max_frame_interval < min_frame_interval) {
+    Gtk::MessageDialog dlg(*this,
+                           _("Invalid logo duration: maximum duration must be greater than or than the minimum duration"),
+                           false, Gtk::MESSAGE_ERROR);
+    dlg.run();
+    return false;
+  }
+
+  return true;
+}
+
+
+void FindLogosWindow::configure_finder(LogoFinder& finder)
+{
+  int min_frame_interval = txt_min_frame_interval_->get_value_as_int();
+  int max_frame_interval = txt_max_frame_interval_->get_value_as_int();
+  finder.set_frame_interval_min(min_frame_interval);
+  finder.set_extra_frames(max_frame_interval - min_frame_interval);
+
+  finder.set_min_logo_width(txt_min_logo_width_->get_value_as_int());
+  finder.set_max_logo_width(txt_max_logo_width_->get_value_as_int());
+  finder.set_min_logo_height(txt_min_logo_height_->get_value_as_int());
+  finder.set_max_logo_height(txt_max_logo_height_->get_value_as_int());
+
+  finder.set_tracking(chk_tracking_->get_active());
+  finder.set_scene_detection(chk_scenes_->get_active());
+  finder.set_progressive(chk_progressive_->get_active());
+  finder.set_pyramid(chk_pyramid_->get_active());
+  finder.set_luma(chk_luma_->get_active());
+}
+
+
+/**
+ * Searches again, more thoroughly and in several threads, only the
+ * frames covered by review filters. Each search stays inside its
+ * review filter, so the filters found replace it.
+ */
+void FindLogosWindow::on_retry_review()
+{
+  if (!check_frame_intervals()) {
+    return;
+  }
+
+  auto spans = filter_data_.filter_list().spans_of_type(fg::FilterType::REVIEW, total_frames_);
+  if (spans.empty()) {
+    Gtk::MessageDialog dlg(*this, _("There are no review filters to search again."),
+                           false, Gtk::MESSAGE_INFO);
+    dlg.run();
+    return;
+  }
+
+  remember_filters();
+  retrier_.reset(new ReviewRetrier(filter_data_.movie_file(), spans,
+                                   finder_progress_dispatcher_, verbose_));
+  retrier_->start(std::max(1u, std::thread::hardware_concurrency()),
+    [this](LogoFinder& finder) {
+      configure_finder(finder);
+      finder.set_thorough(true);
+      finder.set_extra_frames(0);
+      // Each finder would write the same files
+      finder.set_scene_detection(false);
+    });
+
+  search_in_progress_ = true;
+  retry_timer_.start();
+  btn_find_logos_->set_sensitive(false);
+  btn_retry_review_->set_sensitive(false);
+  btn_forget_logos_->set_sensitive(false);
 }
 
 
@@ -207,6 +320,26 @@ bool FindLogosWindow::confirm_search_with_existing_filters()
 }
 
 
+void FindLogosWindow::on_forget_logos()
+{
+  if (!confirmation_dialog(*this,
+                           _("Logos found in previous searches are used to find them faster in other videos. Do you want to forget them?"),
+                           _("_Forget"), _("_Cancel"))) {
+    return;
+  }
+
+  if (std::remove(template_file_.c_str()) != 0 && errno != ENOENT) {
+    Gtk::MessageDialog dlg(*this,
+                           Glib::ustring::compose(_("Could not remove file %1: %2"),
+                                                  template_file_, Glib::strerror(errno)),
+                           false, Gtk::MESSAGE_ERROR);
+    dlg.run();
+    return;
+  }
+  btn_forget_logos_->set_sensitive(false);
+}
+
+
 void FindLogosWindow::on_close()
 {
   if (confirm_stop()) {
@@ -235,6 +368,9 @@ bool FindLogosWindow::confirm_stop()
 
   if (terminate) {
     logo_finder_->stop();
+    if (retrier_) {
+      retrier_->stop();
+    }
   }
 
   return terminate;
@@ -243,22 +379,120 @@ bool FindLogosWindow::confirm_stop()
 
 void FindLogosWindow::on_progress()
 {
+  insert_found_filters();
+
+  if (retrier_) {
+    on_retry_progress();
+    return;
+  }
+
   Progress p = callback_.get_progress();
   progress_bar_->set_progress(p);
 }
 
 
+void FindLogosWindow::remember_filters()
+{
+  const auto& filters = filter_data_.filter_list();
+  known_filters_ = std::map<int, fg::filter_ptr>(filters.begin(), filters.end());
+}
+
+
+/**
+ * Filters are inserted through the model, so that the list is updated
+ * while the search runs.
+ */
+void FindLogosWindow::insert_found_filters()
+{
+  found_filter found;
+  while (found_filters_.pop(found)) {
+    insert_found_filter(found);
+  }
+
+  if (retrier_) {
+    while (retrier_->pop_found_filter(found)) {
+      insert_found_filter(found);
+    }
+  }
+}
+
+
+void FindLogosWindow::insert_found_filter(const found_filter& found)
+{
+  auto current = filter_data_.filter_list().get_by_start_frame(found.first);
+  fg::filter_ptr current_filter = current ? current->second : nullptr;
+  auto known = known_filters_.find(found.first);
+  fg::filter_ptr known_filter = known != known_filters_.end() ? known->second : nullptr;
+  if (current_filter != known_filter) {
+    // Added, changed or removed by the user during the search
+    return;
+  }
+
+  if (current) {
+    filter_model_->remove(filter_model_->get_by_start_frame(found.first));
+  }
+  filter_model_->insert(found.first, found.second);
+  known_filters_[found.first] = found.second;
+}
+
+
+void FindLogosWindow::on_retry_progress()
+{
+  if (retrier_->finished()) {
+    // The workers may have found more after the filters were inserted
+    insert_found_filters();
+
+    search_in_progress_ = false;
+    progress_bar_->set_finished();
+    auto errors = retrier_->errors();
+    if (!errors.empty()) {
+      progress_bar_->set_text(Glib::ustring::compose(_("Process finished unexpectedly: %1"),
+                                                     boost::algorithm::join(errors, "; ")));
+    }
+    retrier_.reset();
+    enable_buttons();
+    return;
+  }
+
+  Progress p;
+  p.percentage = retrier_->get_progress();
+  if (p.percentage > 0) {
+    p.seconds_elapsed = retry_timer_.elapsed();
+    p.calculate_time_remaining();
+    progress_bar_->set_progress(p);
+  }
+}
+
+
 void FindLogosWindow::on_finished()
 {
+  // So that another search can be started
+  worker_thread_->join();
+  delete worker_thread_;
+  worker_thread_ = nullptr;
+
+  // The last results may arrive after the last progress update
+  insert_found_filters();
+
   progress_bar_->set_finished();
   if (!find_result_.first) {
     progress_bar_->set_text(Glib::ustring::compose(_("Process finished unexpectedly: %1"), find_result_.second));
   }
+  enable_buttons();
+
+  if (verbose_) {
+    std::cout << "Logo finder statistics:" << std::endl;
+    logo_finder_->stats().write_json(std::cout);
+  }
 }
 
 
 FindLogosWindow::~FindLogosWindow()
 {
+  if (search_in_progress_) {
+    logo_finder_->stop();
+  }
+
   if (worker_thread_) {
     if (worker_thread_->joinable()) {
       worker_thread_->join();
@@ -268,20 +502,26 @@ FindLogosWindow::~FindLogosWindow()
 }
 
 
-FindLogosWindow::ProgressCallback::ProgressCallback(Glib::Dispatcher& dispatcher)
+FindLogosWindow::ProgressCallback::ProgressCallback(Glib::Dispatcher& dispatcher,
+                                                    SPSCQueue<found_filter>& found_filters)
   : dispatcher_(dispatcher)
+  , found_filters_(found_filters)
 {
 }
 
 
 void FindLogosWindow::ProgressCallback::success(const mdl::LogoFinderResult& result)
 {
+  found_filters_.push(std::make_pair(result.start_frame + 1,
+                                     fg::filter_ptr(new fg::DelogoFilter(result.x, result.y,
+                                                                         result.width, result.height))));
   calculate_progress(result.end_frame);
 }
 
 
 void FindLogosWindow::ProgressCallback::failure(int start_frame, int end_frame)
 {
+  found_filters_.push(std::make_pair(start_frame + 1, fg::filter_ptr(new fg::ReviewFilter())));
   calculate_progress(end_frame);
 }
 
@@ -326,3 +566,11 @@ Progress FindLogosWindow::ProgressCallback::get_progress() const
 
   return progress_;
 }
+
+
+void FindLogosWindow::enable_buttons()
+{
+  btn_find_logos_->set_sensitive(true);
+  btn_retry_review_->set_sensitive(true);
+  btn_forget_logos_->set_sensitive(Glib::file_test(template_file_, Glib::FILE_TEST_EXISTS));
+}
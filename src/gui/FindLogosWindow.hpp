@@ -19,18 +19,25 @@
 #ifndef MDL_FIND_LOGOS_WINDOW_H
 #define MDL_FIND_LOGOS_WINDOW_H
 
+#include <string>
 #include <memory>
+#include <map>
 #include <thread>
 #include <mutex>
+#include <utility>
 
 #include <gtkmm.h>
 
 #include "filter-generator/FilterData.hpp"
+#include "filter-generator/Filters.hpp"
 
 #include "common/LogoFinder.hpp"
 
 #include "ETRProgressBar.hpp"
 #include "MultiDelogoAppWindow.hpp"
+#include "FilterListModel.hpp"
+#include "SPSCQueue.hpp"
+#include "ReviewRetrier.hpp"
 
 
 namespace mdl {
@@ -38,18 +45,21 @@ namespace mdl {
   {
   public:
     static FindLogosWindow* create(fg::FilterData& filter_data,
+                                   const Glib::RefPtr<FilterListModel>& filter_model,
                                    int total_frames, int start_frame, int jump_size,
                                    bool verbose);
 
     FindLogosWindow(BaseObjectType* cobject,
                     const Glib::RefPtr<Gtk::Builder>& builder,
                     fg::FilterData& filter_data,
+                    const Glib::RefPtr<FilterListModel>& filter_model,
                     int total_frames, int start_frame, int jump_size,
                     bool verbose);
     ~FindLogosWindow();
 
   private:
     fg::FilterData& filter_data_;
+    Glib::RefPtr<FilterListModel> filter_model_;
     std::shared_ptr<LogoFinder> logo_finder_;
 
     Gtk::SpinButton* txt_initial_frame_;
@@ -62,16 +72,45 @@ namespace mdl {
     Gtk::SpinButton* txt_min_logo_height_;
     Gtk::SpinButton* txt_max_logo_height_;
 
+    Gtk::CheckButton* chk_tracking_;
+    Gtk::CheckButton* chk_scenes_;
+    Gtk::CheckButton* chk_progressive_;
+    Gtk::CheckButton* chk_pyramid_;
+    Gtk::CheckButton* chk_luma_;
+
     ETRProgressBar* progress_bar_;
 
     Gtk::Button* btn_find_logos_;
+    Gtk::Button* btn_retry_review_;
+    Gtk::Button* btn_forget_logos_;
+
+    int total_frames_;
+    /** Library of known logos, empty if there is nowhere to keep it */
+    std::string template_file_;
 
     std::thread* worker_thread_;
     bool search_in_progress_;
+    bool verbose_;
     LogoFinder::find_result find_result_;
     Glib::Dispatcher finder_progress_dispatcher_;
     Glib::Dispatcher finder_finished_dispatcher_;
 
+    /** Start frame (1-based) and filter of each result */
+    typedef std::pair<int, fg::filter_ptr> found_filter;
+    // Filled by the finder thread, and emptied into the filter list
+    // by the GUI thread while the search runs
+    SPSCQueue<found_filter> found_filters_;
+
+    // The filters as this window last saw them. Found filters are not
+    // inserted where the user changed a filter meanwhile, since the
+    // undo list refers to the user's filter.
+    std::map<int, fg::filter_ptr> known_filters_;
+
+    // Only while retrying review filters. Declared after the
+    // dispatchers, so that it is destroyed first.
+    std::unique_ptr<ReviewRetrier> retrier_;
+    Glib::Timer retry_timer_;
+
 
     void configure_widgets(const Glib::RefPtr<Gtk::Builder>& builder,
                            int total_frames, int start_frame, int jump_size);
@@ -79,22 +118,31 @@ namespace mdl {
     void configure_spin(Gtk::SpinButton& spin, int max);
 
     void on_find_logos();
+    bool check_frame_intervals();
+    void configure_finder(LogoFinder& finder);
+    void on_retry_review();
     bool already_has_filters();
     bool confirm_search_with_existing_filters();
+    void on_forget_logos();
 
     void on_close();
     bool on_delete_event(GdkEventAny*) override;
     bool confirm_stop();
 
     void on_progress();
+    void remember_filters();
+    void insert_found_filters();
+    void insert_found_filter(const found_filter& found);
+    void on_retry_progress();
 
     void on_finished();
+    void enable_buttons();
 
 
     class ProgressCallback : public mdl::LogoFinderCallback
     {
     public:
-      ProgressCallback(Glib::Dispatcher& dispatcher);
+      ProgressCallback(Glib::Dispatcher& dispatcher, SPSCQueue<found_filter>& found_filters);
 
       void success(const mdl::LogoFinderResult& result) override;
       void failure(int start_frame, int end_frame) override;
@@ -115,6 +163,7 @@ namespace mdl {
       Glib::Timer timer_;
 
       Glib::Dispatcher& dispatcher_;
+      SPSCQueue<found_filter>& found_filters_;
 
 
       void calculate_progress(int end_frame);
@@ -16,17 +16,22 @@
  * You should have received a copy of the GNU General Public License
  * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
  */
+#include <cmath>
+
 #include <boost/algorithm/clamp.hpp>
 
 #include <gtkmm.h>
 #include <glibmm/i18n.h>
 
+#include "filter-generator/FilterFactory.hpp"
+
 #include "common/Exceptions.hpp"
 #include "common/FrameProvider.hpp"
 
 #include "FrameNavigator.hpp"
 #include "FrameNavigatorUtil.hpp"
 #include "FrameView.hpp"
+#include "FilterPreview.hpp"
 #include "Utils.hpp"
 
 using namespace mdl;
@@ -52,6 +57,7 @@ FrameNavigator::FrameNavigator(BaseObjectType* cobject,
   , btn_zoom_out_(nullptr)
   , btn_zoom_in_(nullptr)
   , btn_zoom_100_(nullptr)
+  , preview_enabled_(false)
 {
   builder->get_widget_derived("frame_view", frame_view_,
                               frame_provider_->get_frame_width(), frame_provider_->get_frame_height());
@@ -68,6 +74,9 @@ FrameNavigator::FrameNavigator(BaseObjectType* cobject,
   configure_zoom_bar(builder);
 
   empty_pixbuf_ = Gdk::Pixbuf::create(Gdk::COLORSPACE_RGB, false, 8, 1, 1);
+
+  preview_.signal_ready().connect(sigc::mem_fun(*this, &FrameNavigator::on_preview_ready));
+  frame_view_->signal_rectangle_dragged().connect(sigc::mem_fun(*this, &FrameNavigator::on_rectangle_dragged));
 }
 
 
@@ -181,6 +190,7 @@ void FrameNavigator::change_displayed_frame(int new_frame_number)
     signal_frame_changed_.emit(new_frame_number);
     frame_number_ = new_frame_number;
     txt_frame_number_->set_value(frame_number_);
+    update_preview();
 
     long time_pos = calculate_position((frame_number_ - 1), get_fps());
     lbl_time_pos_->set_label(format_time_based_on_total(time_pos, duration_));
@@ -302,6 +312,51 @@ void FrameNavigator::set_show_prev_frame(PrevFrame setting)
 }
 
 
+void FrameNavigator::set_preview(bool enabled)
+{
+  preview_enabled_ = enabled;
+  update_preview();
+}
+
+
+void FrameNavigator::set_preview_filter(fg::filter_ptr filter)
+{
+  preview_filter_ = filter;
+}
+
+
+void FrameNavigator::update_preview()
+{
+  if (preview_enabled_ && FilterPreview::can_preview(preview_filter_)) {
+    preview_.request(frame_number_, frame_pixbuf_, preview_filter_);
+  } else {
+    preview_.cancel();
+    frame_view_->set_image(frame_pixbuf_);
+  }
+}
+
+
+void FrameNavigator::on_preview_ready(int frame_number, Glib::RefPtr<Gdk::Pixbuf> pixbuf)
+{
+  if (frame_number == frame_number_) {
+    frame_view_->set_image(pixbuf);
+  }
+}
+
+
+void FrameNavigator::on_rectangle_dragged(Rectangle rect)
+{
+  if (!preview_enabled_ || !FilterPreview::can_preview(preview_filter_)) {
+    return;
+  }
+
+  auto filter = fg::FilterFactory::create(preview_filter_->type(),
+                                          std::lround(rect.x), std::lround(rect.y),
+                                          std::lround(rect.width), std::lround(rect.height));
+  preview_.request(frame_number_, frame_pixbuf_, filter);
+}
+
+
 FrameView* FrameNavigator::get_frame_view()
 {
   return frame_view_;
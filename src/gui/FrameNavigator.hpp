@@ -21,10 +21,13 @@
 
 #include <gtkmm.h>
 
+#include "filter-generator/Filters.hpp"
+
 #include "common/FrameProvider.hpp"
 
 #include "NumericEntry.hpp"
 #include "FrameView.hpp"
+#include "FilterPreview.hpp"
 
 
 namespace mdl {
@@ -50,6 +53,11 @@ namespace mdl {
     enum class PrevFrame { NO, FIT, SAME };
     void set_show_prev_frame(PrevFrame setting);
 
+    void set_preview(bool enabled);
+    /** Takes effect when the frame changes or update_preview() is called */
+    void set_preview_filter(fg::filter_ptr filter);
+    void update_preview();
+
     FrameView* get_frame_view();
 
     typedef sigc::signal<void, int> type_signal_frame_changed;
@@ -86,6 +94,10 @@ namespace mdl {
     PrevFrame prev_frame_setting_;
     sigc::connection prev_frame_view_on_size_allocate_;
 
+    FilterPreview preview_;
+    bool preview_enabled_;
+    fg::filter_ptr preview_filter_;
+
 
     void configure_navigation_bar(const Glib::RefPtr<Gtk::Builder>& builder);
     void configure_zoom_bar(const Glib::RefPtr<Gtk::Builder>& builder);
@@ -96,6 +108,9 @@ namespace mdl {
     void fetch_and_show_current_frame(int new_frame_number);
     void fetch_and_show_prev_frame(int new_frame_number);
 
+    void on_preview_ready(int frame_number, Glib::RefPtr<Gdk::Pixbuf> pixbuf);
+    void on_rectangle_dragged(Rectangle rect);
+
     void on_frame_number_activate();
     bool on_frame_number_input(GdkEventFocus*);
 
@@ -91,6 +91,7 @@ FrameView::FrameView(BaseObjectType* cobject,
   if (can_select_rectangle) {
     rect_->enable_drag_and_drop();
     rect_->signal_rectangle_changed().connect(sigc::mem_fun(signal_rectangle_changed_, &type_signal_rectangle_changed::emit));
+    rect_->signal_rectangle_dragged().connect(sigc::mem_fun(signal_rectangle_dragged_, &type_signal_rectangle_changed::emit));
   }
 
   temp_rect_ = new SelectionRect();
@@ -140,6 +141,12 @@ FrameView::type_signal_rectangle_changed FrameView::signal_rectangle_changed()
 }
 
 
+FrameView::type_signal_rectangle_changed FrameView::signal_rectangle_dragged()
+{
+  return signal_rectangle_dragged_;
+}
+
+
 bool FrameView::on_button_press(GooCanvasItem* item, GdkEventButton* event)
 {
   if (event->button != 1) {
@@ -171,6 +178,7 @@ bool FrameView::on_motion_notify(GooCanvasItem* item, GdkEventMotion* event)
     temp_rect_->set_coordinates({.x = drag_start_.x, .y = drag_start_.y,
                                  .width = width, .height = height});
     temp_rect_->set_visible(true);
+    signal_rectangle_dragged_.emit(temp_rect_->get_coordinates());
   }
 
   return true;
@@ -312,6 +320,12 @@ SelectionRect::type_signal_rectangle_changed SelectionRect::signal_rectangle_cha
 }
 
 
+SelectionRect::type_signal_rectangle_changed SelectionRect::signal_rectangle_dragged()
+{
+  return signal_rectangle_dragged_;
+}
+
+
 Rectangle SelectionRect::normalize(const Rectangle& original)
 {
   Rectangle ret(original);
@@ -506,6 +520,7 @@ bool SelectionRect::on_motion_notify(GooCanvasItem* item, GdkEventMotion* event)
   }
 
   set_coordinates(get_new_coordinates({.x = event->x, .y = event->y}));
+  signal_rectangle_dragged_.emit(get_coordinates());
 
   return true;
 }
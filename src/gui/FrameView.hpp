@@ -47,6 +47,8 @@ namespace mdl {
 
     typedef sigc::signal<void, Rectangle> type_signal_rectangle_changed;
     type_signal_rectangle_changed signal_rectangle_changed();
+    /** Emitted while the rectangle is being dragged, before it is changed */
+    type_signal_rectangle_changed signal_rectangle_dragged();
 
     ~FrameView();
 
@@ -72,6 +74,7 @@ namespace mdl {
     Point drag_start_;
 
     type_signal_rectangle_changed signal_rectangle_changed_;
+    type_signal_rectangle_changed signal_rectangle_dragged_;
 
 
     bool on_button_press(GooCanvasItem* item, GdkEventButton* event);
@@ -113,6 +116,7 @@ namespace mdl {
 
     typedef sigc::signal<void, Rectangle> type_signal_rectangle_changed;
     type_signal_rectangle_changed signal_rectangle_changed();
+    type_signal_rectangle_changed signal_rectangle_dragged();
 
     friend bool sr_on_button_press_wrapper(GooCanvasItem* item,
                                            GooCanvasItem* target_item,
@@ -152,6 +156,7 @@ namespace mdl {
     Glib::RefPtr<Gdk::Cursor> resize_r_cursor_;
 
     type_signal_rectangle_changed signal_rectangle_changed_;
+    type_signal_rectangle_changed signal_rectangle_dragged_;
 
 
     Rectangle normalize(const Rectangle& original);
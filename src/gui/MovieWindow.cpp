@@ -24,11 +24,16 @@
 #include "common/FrameProvider.hpp"
 
 #include "filter-generator/FilterData.hpp"
+#include "filter-generator/FilterJournal.hpp"
+#include "filter-generator/Exceptions.hpp"
 
 #include "MovieWindow.hpp"
 #include "FilterList.hpp"
 #include "FrameNavigator.hpp"
 #include "Coordinator.hpp"
+#include "BackgroundFinder.hpp"
+#include "ProjectSaver.hpp"
+#include "FilterListModel.hpp"
 #include "MultiDelogoApp.hpp"
 #include "FindLogosWindow.hpp"
 #include "EncodeWindow.hpp"
@@ -64,6 +69,9 @@ MovieWindow::MovieWindow(BaseObjectType* cobject,
   , filter_list_(nullptr)
   , frame_navigator_(nullptr)
   , coordinator_(*this, frame_provider->get_number_of_frames(), frame_provider->get_frame_width(), frame_provider->get_frame_height())
+  , find_logos_window_(nullptr)
+  , box_suggestions_(nullptr)
+  , suggestion_view_(nullptr)
 {
   set_title(Glib::ustring::compose("multi-delogo: %1",
                                    Glib::path_get_basename(project_file)));
@@ -78,8 +86,20 @@ MovieWindow::MovieWindow(BaseObjectType* cobject,
                               *this, frame_provider);
   frame_navigator_->set_jump_size(filter_data_->jump_size());
   coordinator_.set_frame_navigator(frame_navigator_);
+  frame_navigator_->signal_frame_changed().connect(sigc::mem_fun(*this, &MovieWindow::on_frame_changed));
+
+  builder->get_widget("box_suggestions", box_suggestions_);
+  builder->get_widget("suggestion_view", suggestion_view_);
+  suggestion_view_->signal_row_activated().connect(sigc::mem_fun(*this, &MovieWindow::on_suggestion_activated));
 
   signal_key_press_event().connect(sigc::mem_fun(*this, &MovieWindow::on_key_press));
+
+  try {
+    project_saver_.reset(new ProjectSaver(project_file_, *filter_data_));
+    project_saver_->signal_write_failed().connect(sigc::mem_fun(*this, &MovieWindow::on_save_failed));
+  } catch (fg::JournalNotOpenedException& e) {
+    // on_save() writes the whole project
+  }
 }
 
 
@@ -115,6 +135,12 @@ void MovieWindow::configure_toolbar(const Glib::RefPtr<Gtk::Builder>& builder,
     sigc::bind(sigc::mem_fun(*this, &MovieWindow::on_scroll_filter_toggled),
                chk_scroll_filter));
 
+  Gtk::ToggleToolButton* chk_preview = nullptr;
+  builder->get_widget("chk_preview", chk_preview);
+  chk_preview->signal_toggled().connect(
+    sigc::bind(sigc::mem_fun(*this, &MovieWindow::on_preview_toggled),
+               chk_preview));
+
   Gtk::RadioMenuItem* chk_prev_frame_no = nullptr;
   builder->get_widget("chk_prev_frame_no", chk_prev_frame_no);
   chk_prev_frame_no->signal_toggled().connect(
@@ -138,6 +164,12 @@ void MovieWindow::configure_toolbar(const Glib::RefPtr<Gtk::Builder>& builder,
   builder->get_widget("btn_find_logos", btn_find_logos);
   gtk_actionable_set_action_name(GTK_ACTIONABLE(btn_find_logos->gobj()), "win.find-logos");
 
+  Gtk::ToggleToolButton* chk_suggest = nullptr;
+  builder->get_widget("chk_suggest", chk_suggest);
+  chk_suggest->signal_toggled().connect(
+    sigc::bind(sigc::mem_fun(*this, &MovieWindow::on_suggest_toggled),
+               chk_suggest));
+
   add_action("encode", sigc::mem_fun(*this, &MovieWindow::on_encode));
   Gtk::ToolButton* btn_encode = nullptr;
   builder->get_widget("btn_encode", btn_encode);
@@ -177,6 +209,11 @@ bool MovieWindow::on_key_press(GdkEventKey* key_event)
   case GDK_KEY_v:
     coordinator_.on_next_filter();
     return true;
+
+  case GDK_KEY_E:
+  case GDK_KEY_e:
+    on_accept_suggestion();
+    return true;
   }
 
   return false;
@@ -186,26 +223,134 @@ bool MovieWindow::on_key_press(GdkEventKey* key_event)
 void MovieWindow::on_save()
 {
   filter_data_->set_jump_size(frame_navigator_->get_jump_size());
-  get_application()->save_project(project_file_, *filter_data_);
+  if (project_saver_) {
+    project_saver_->save();
+  } else {
+    get_application()->save_project(project_file_, *filter_data_);
+  }
+}
+
+
+void MovieWindow::on_save_failed(int error)
+{
+  auto msg = Glib::ustring::compose(_("Could not write file %1: %2"),
+                                    project_file_, Glib::strerror(error));
+  Gtk::MessageDialog dlg(*this, msg, false, Gtk::MESSAGE_ERROR);
+  dlg.run();
+}
+
+
+/**
+ * Used when editing ends, so that the project file has all the
+ * changes and the journal is not needed anymore
+ */
+void MovieWindow::save_whole_project()
+{
+  filter_data_->set_jump_size(frame_navigator_->get_jump_size());
+  project_saver_.reset();
+
+  if (get_application()->save_project(project_file_, *filter_data_)) {
+    fg::FilterJournal::remove(project_file_);
+  }
 }
 
 
 void MovieWindow::on_find_logos()
 {
+  if (find_logos_window_) {
+    find_logos_window_->present();
+    return;
+  }
+
   FindLogosWindow* window
     = FindLogosWindow::create(*filter_data_,
+                              filter_list_->get_model(),
                               frame_navigator_->get_number_of_frames(),
                               coordinator_.get_current_frame(),
                               frame_navigator_->get_jump_size(),
                               get_application()->is_verbose());
+  // Not modal, so that the filters found can be reviewed while the
+  // search runs
   window->set_transient_for(*this);
-  window->set_modal();
-  window->signal_hide().connect(sigc::mem_fun(*filter_list_, &FilterList::refresh_list));
+  window->set_destroy_with_parent();
+  window->signal_hide().connect(sigc::mem_fun(*this, &MovieWindow::on_find_logos_hidden));
+  find_logos_window_ = window;
 
   get_application()->register_window(window);
 }
 
 
+void MovieWindow::on_find_logos_hidden()
+{
+  find_logos_window_ = nullptr;
+}
+
+
+/**
+ * While enabled, logos are searched for in the background, ahead of
+ * the frame being displayed, and listed as suggestions
+ */
+void MovieWindow::on_suggest_toggled(Gtk::ToggleToolButton* chk)
+{
+  if (!chk->get_active()) {
+    suggestion_view_->unset_model();
+    suggestion_view_->remove_all_columns();
+    background_finder_.reset();
+    box_suggestions_->hide();
+    return;
+  }
+
+  background_finder_.reset(new BackgroundFinder(filter_data_->movie_file(),
+                                                frame_navigator_->get_number_of_frames(),
+                                                frame_navigator_->get_jump_size(),
+                                                get_application()->is_verbose()));
+  auto model = background_finder_->get_model();
+  suggestion_view_->set_model(model);
+  suggestion_view_->append_column(_("Start frame"), model->columns.start_frame);
+  suggestion_view_->append_column(_("Filter"), model->columns.filter_name);
+  box_suggestions_->show();
+
+  background_finder_->set_position(coordinator_.get_current_frame());
+}
+
+
+void MovieWindow::on_suggestion_activated(const Gtk::TreeModel::Path& path, Gtk::TreeViewColumn*)
+{
+  auto iter = background_finder_->get_model()->get_iter(path);
+  frame_navigator_->change_displayed_frame((*iter)[FilterListModel::columns.start_frame]);
+}
+
+
+/**
+ * Adds the suggestion applied to the frame being displayed to the
+ * filters
+ */
+void MovieWindow::on_accept_suggestion()
+{
+  if (!background_finder_) {
+    return;
+  }
+
+  auto suggestion = background_finder_->get_suggestion_for_frame(coordinator_.get_current_frame());
+  if (!suggestion) {
+    return;
+  }
+
+  int start_frame = suggestion->first;
+  fg::filter_ptr filter = suggestion->second;
+  background_finder_->remove_suggestion(start_frame);
+  coordinator_.add_filter(start_frame, filter);
+}
+
+
+void MovieWindow::on_frame_changed(int frame)
+{
+  if (background_finder_) {
+    background_finder_->set_position(frame);
+  }
+}
+
+
 void MovieWindow::on_encode()
 {
   if (filter_data_->filter_list().empty()) {
@@ -220,7 +365,7 @@ void MovieWindow::on_encode()
     return;
   }
 
-  on_save();
+  save_whole_project();
 
   EncodeWindow* window = EncodeWindow::create(std::move(filter_data_),
                                               frame_navigator_->get_frame_width(), frame_navigator_->get_frame_height(),
@@ -238,6 +383,12 @@ void MovieWindow::on_scroll_filter_toggled(Gtk::ToggleToolButton* chk)
 }
 
 
+void MovieWindow::on_preview_toggled(Gtk::ToggleToolButton* chk)
+{
+  frame_navigator_->set_preview(chk->get_active());
+}
+
+
 void MovieWindow::on_set_prev_frame(Gtk::RadioMenuItem* radio, FrameNavigator::PrevFrame setting)
 {
   // The signal is emitted for the item that is unchecked and for the item that is checked, so we ignore unchecking signals
@@ -251,8 +402,10 @@ void MovieWindow::on_set_prev_frame(Gtk::RadioMenuItem* radio, FrameNavigator::P
 
 void MovieWindow::on_hide()
 {
+  background_finder_.reset();
+
   // When this is called because of on_encode there is no filter_data_ anymore
   if (filter_data_) {
-    on_save();
+    save_whole_project();
   }
 }
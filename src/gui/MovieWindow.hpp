@@ -31,6 +31,9 @@
 #include "FilterList.hpp"
 #include "FrameNavigator.hpp"
 #include "Coordinator.hpp"
+#include "BackgroundFinder.hpp"
+#include "FindLogosWindow.hpp"
+#include "ProjectSaver.hpp"
 
 
 namespace mdl {
@@ -55,21 +58,40 @@ namespace mdl {
 
     std::string project_file_;
     std::unique_ptr<fg::FilterData> filter_data_;
+    // Null if the journal could not be opened, in which case the
+    // project is always written whole
+    std::unique_ptr<ProjectSaver> project_saver_;
 
     FilterList* filter_list_;
     FrameNavigator* frame_navigator_;
     Coordinator coordinator_;
 
+    // Only one search at a time, since the searches would insert
+    // into the same filters and write the same logo templates
+    FindLogosWindow* find_logos_window_;
+
+    Gtk::Widget* box_suggestions_;
+    Gtk::TreeView* suggestion_view_;
+    std::unique_ptr<BackgroundFinder> background_finder_;
+
     void configure_toolbar(const Glib::RefPtr<Gtk::Builder>& builder,
                            Gtk::Application& app);
 
     bool on_key_press(GdkEventKey* key_event);
 
     void on_save();
+    void on_save_failed(int error);
+    void save_whole_project();
     void on_find_logos();
+    void on_find_logos_hidden();
+    void on_suggest_toggled(Gtk::ToggleToolButton* chk);
+    void on_suggestion_activated(const Gtk::TreeModel::Path& path, Gtk::TreeViewColumn*);
+    void on_accept_suggestion();
+    void on_frame_changed(int frame);
     void on_encode();
 
     void on_scroll_filter_toggled(Gtk::ToggleToolButton* chk);
+    void on_preview_toggled(Gtk::ToggleToolButton* chk);
     void on_set_prev_frame(Gtk::RadioMenuItem* radio, FrameNavigator::PrevFrame setting);
 
     void on_hide() override;
@@ -19,12 +19,15 @@
 #include <cerrno>
 #include <string>
 #include <iostream>
+#include <sstream>
 #include <fstream>
+#include <iterator>
 
 #include <gtkmm.h>
 #include <glibmm/i18n.h>
 
 #include "filter-generator/FilterData.hpp"
+#include "filter-generator/FilterJournal.hpp"
 #include "filter-generator/Exceptions.hpp"
 
 #include "common/Exceptions.hpp"
@@ -33,6 +36,7 @@
 #include "MultiDelogoApp.hpp"
 #include "InitialWindow.hpp"
 #include "MovieWindow.hpp"
+#include "ProjectSaver.hpp"
 #include "Utils.hpp"
 
 using namespace mdl;
@@ -141,15 +145,37 @@ MultiDelogoApp::maybe_Project MultiDelogoApp::open_or_create_project(const std::
 
 MultiDelogoApp::maybe_Project MultiDelogoApp::open_project(const std::string& project_file, std::istream& project_file_stream)
 {
+  // Kept to load it again if the journal can't be applied
+  std::string contents((std::istreambuf_iterator<char>(project_file_stream)),
+                       std::istreambuf_iterator<char>());
+
   std::unique_ptr<fg::FilterData> filter_data(new fg::FilterData());
   try {
-    filter_data->load(project_file_stream);
+    std::istringstream in(contents);
+    filter_data->load(in);
   } catch (fg::Exception& e) {
     auto msg = Glib::ustring::compose(_("Invalid data in file %1"), project_file);
     error_dialog(msg);
     return boost::none;
   }
 
+  try {
+    // Changes not written whole when the program last closed. The
+    // project is written with them, so that the journal starts again.
+    if (fg::FilterJournal::replay(project_file, *filter_data)
+        && save_project(project_file, *filter_data)) {
+      fg::FilterJournal::remove(project_file);
+    }
+  } catch (fg::Exception& e) {
+    filter_data.reset(new fg::FilterData());
+    std::istringstream in(contents);
+    filter_data->load(in);
+    fg::FilterJournal::remove(project_file);
+
+    auto msg = Glib::ustring::compose(_("The changes to %1 not saved when the program last closed are invalid, and were discarded"), project_file);
+    error_dialog(msg, Gtk::MESSAGE_WARNING);
+  }
+
   Project pr{.file = project_file, .filter_data = std::move(filter_data)};
   return pr;
 }
@@ -165,6 +191,8 @@ MultiDelogoApp::maybe_Project MultiDelogoApp::create_project(const std::string&
     open_file(project_file);
     return boost::none;
   }
+  // The journal of the project being replaced doesn't apply to the new one
+  fg::FilterJournal::remove(project_file);
 
   std::unique_ptr<fg::FilterData> filter_data(new fg::FilterData());
   filter_data->set_movie_file(movie_file);
@@ -235,18 +263,20 @@ void MultiDelogoApp::on_hide_window(Gtk::ApplicationWindow* window)
 }
 
 
-void MultiDelogoApp::save_project(const std::string& project_file,
+bool MultiDelogoApp::save_project(const std::string& project_file,
                                   const fg::FilterData& filter_data)
 {
-  std::ofstream file_stream(project_file);
-  if (!file_stream.is_open()) {
-    auto msg = Glib::ustring::compose(_("Could not open file %1: %2"),
+  std::ostringstream out;
+  filter_data.save(out);
+
+  if (!ProjectSaver::write_file(project_file, out.str())) {
+    auto msg = Glib::ustring::compose(_("Could not write file %1: %2"),
                                       project_file, Glib::strerror(errno));
     error_dialog(msg);
-    return;
+    return false;
   }
 
-  filter_data.save(file_stream);
+  return true;
 }
 
 
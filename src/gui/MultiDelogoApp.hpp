@@ -39,7 +39,8 @@ namespace mdl {
   public:
     static Glib::RefPtr<MultiDelogoApp> create();
 
-    void save_project(const std::string& project_file,
+    /** Writes the whole project. Returns false if it failed */
+    bool save_project(const std::string& project_file,
                       const fg::FilterData& filter_data);
 
     void register_window(Gtk::ApplicationWindow* window);
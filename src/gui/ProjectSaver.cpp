@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstdio>
+#include <cerrno>
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <thread>
+
+#include <glibmm/main.h>
+#include <glibmm/dispatcher.h>
+
+#include "filter-generator/FilterData.hpp"
+#include "filter-generator/FilterJournal.hpp"
+
+#include "ProjectSaver.hpp"
+#include "Utils.hpp"
+
+using namespace mdl;
+
+
+ProjectSaver::ProjectSaver(const std::string& project_file, fg::FilterData& filter_data)
+  : project_file_(project_file)
+  , filter_data_(filter_data)
+  , journal_(project_file)
+  , written_(false)
+  , write_error_(0)
+  , save_pending_(false)
+{
+  written_dispatcher_.connect(sigc::mem_fun(*this, &ProjectSaver::on_written));
+  filter_data_.set_journal(&journal_);
+  flush_timeout_ = Glib::signal_timeout().connect_seconds(
+    sigc::mem_fun(*this, &ProjectSaver::on_flush_timeout), FLUSH_INTERVAL_S_);
+
+  // The journal is only useful with the project it applies to
+  if (!file_exists(project_file_)) {
+    compact();
+  }
+}
+
+
+ProjectSaver::~ProjectSaver()
+{
+  flush_timeout_.disconnect();
+  filter_data_.set_journal(nullptr);
+  journal_.flush();
+
+  if (thread_.joinable()) {
+    thread_.join();
+    if (written_) {
+      journal_.remove_previous();
+    }
+  }
+}
+
+
+void ProjectSaver::save()
+{
+  journal_.flush();
+
+  if (thread_.joinable()) {
+    // The project being written doesn't have the latest changes
+    save_pending_ = true;
+  } else {
+    compact();
+  }
+}
+
+
+bool ProjectSaver::write_file(const std::string& file, const std::string& contents)
+{
+  std::string tmp_file = file + ".tmp";
+  {
+    std::ofstream out(tmp_file);
+    if (!out.is_open() || !(out << contents) || !out.flush()) {
+      std::remove(tmp_file.c_str());
+      return false;
+    }
+  }
+
+  return std::rename(tmp_file.c_str(), file.c_str()) == 0;
+}
+
+
+ProjectSaver::type_signal_write_failed ProjectSaver::signal_write_failed()
+{
+  return signal_write_failed_;
+}
+
+
+bool ProjectSaver::on_flush_timeout()
+{
+  journal_.flush();
+
+  if (journal_.records() >= COMPACT_RECORDS_ && !thread_.joinable()) {
+    compact();
+  }
+
+  return true;
+}
+
+
+/**
+ * Only serializing the project is done here; writing it, which is
+ * what takes time, is done in a thread. Changes made meanwhile go to
+ * the new journal.
+ */
+void ProjectSaver::compact()
+{
+  journal_.rotate();
+
+  std::ostringstream out;
+  filter_data_.save(out);
+
+  thread_ = std::thread([this, contents = out.str()] {
+      written_ = write_file(project_file_, contents);
+      write_error_ = written_ ? 0 : errno;
+      written_dispatcher_.emit();
+  });
+}
+
+
+void ProjectSaver::on_written()
+{
+  thread_.join();
+  if (written_) {
+    journal_.remove_previous();
+  } else {
+    signal_write_failed_.emit(write_error_);
+  }
+
+  if (save_pending_) {
+    save_pending_ = false;
+    compact();
+  }
+}
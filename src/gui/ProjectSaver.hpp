@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MDL_PROJECT_SAVER_H
+#define MDL_PROJECT_SAVER_H
+
+#include <string>
+#include <thread>
+
+#include <sigc++/sigc++.h>
+#include <glibmm/dispatcher.h>
+
+#include "filter-generator/FilterData.hpp"
+#include "filter-generator/FilterJournal.hpp"
+
+
+namespace mdl {
+  /**
+   * Saves a project while it is edited. Changes are recorded in the
+   * project journal as they are made, and the journal is written
+   * every second, so little is lost if the program crashes. Saving
+   * writes the project whole in a thread, so that the interface
+   * doesn't wait for it however large the project is, and starts a
+   * new journal. That is also done when the journal has grown.
+   *
+   * The project is not written when the saver is destroyed; that is
+   * done when editing ends, after which the journal can be removed.
+   */
+  class ProjectSaver
+  {
+  public:
+    /** Throws fg::JournalNotOpenedException */
+    ProjectSaver(const std::string& project_file, fg::FilterData& filter_data);
+    ~ProjectSaver();
+
+    ProjectSaver(const ProjectSaver&) = delete;
+    ProjectSaver& operator=(const ProjectSaver&) = delete;
+
+    void save();
+
+    /** Writes contents to a new file, renamed to file when complete */
+    static bool write_file(const std::string& file, const std::string& contents);
+
+    /** Emitted with errno when the project could not be written */
+    typedef sigc::signal<void, int> type_signal_write_failed;
+    type_signal_write_failed signal_write_failed();
+
+  private:
+    static const int COMPACT_RECORDS_ = 10000;
+    static const int FLUSH_INTERVAL_S_ = 1;
+
+    std::string project_file_;
+    fg::FilterData& filter_data_;
+    fg::FilterJournal journal_;
+
+    sigc::connection flush_timeout_;
+
+    std::thread thread_;
+    // Only read after thread_ is joined
+    bool written_;
+    int write_error_;
+    Glib::Dispatcher written_dispatcher_;
+    /** Whether to write the project again once thread_ finishes */
+    bool save_pending_;
+
+    type_signal_write_failed signal_write_failed_;
+
+
+    bool on_flush_timeout();
+    void compact();
+    void on_written();
+  };
+}
+
+#endif // MDL_PROJECT_SAVER_H
@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <algorithm>
+
+#include <glibmm/dispatcher.h>
+
+#include "filter-generator/Filters.hpp"
+
+#include "common/LogoFinder.hpp"
+
+#include "ReviewRetrier.hpp"
+
+using namespace mdl;
+
+
+ReviewRetrier::ReviewRetrier(const std::string& movie_file,
+                             const std::vector<std::pair<int, int>>& spans,
+                             Glib::Dispatcher& progress_dispatcher,
+                             bool verbose)
+  : movie_file_(movie_file)
+  , spans_(spans)
+  , progress_dispatcher_(progress_dispatcher)
+  , verbose_(verbose)
+  , next_span_(0)
+  , frames_done_(0)
+  , workers_running_(0)
+  , total_frames_(0)
+{
+  for (const auto& span: spans_) {
+    total_frames_ += span.second - span.first + 1;
+  }
+}
+
+
+ReviewRetrier::~ReviewRetrier()
+{
+  stop();
+  for (auto& worker: workers_) {
+    if (worker->thread_.joinable()) {
+      worker->thread_.join();
+    }
+  }
+}
+
+
+/**
+ * Longer spans are searched first, so that no thread is left with a
+ * long one at the end while the others are idle.
+ */
+void ReviewRetrier::start(int n_threads, const configure_function& configure)
+{
+  std::stable_sort(spans_.begin(), spans_.end(),
+    [](const auto& span1, const auto& span2) {
+      return span1.second - span1.first > span2.second - span2.first;
+    });
+
+  n_threads = std::max(1, std::min<int>(n_threads, spans_.size()));
+  for (int i = 0; i < n_threads; ++i) {
+    std::unique_ptr<Worker> worker(new Worker(*this));
+    worker->finder_ = create_logo_finder(movie_file_, *worker, verbose_);
+    configure(*worker->finder_);
+    workers_.push_back(std::move(worker));
+  }
+
+  workers_running_ = workers_.size();
+  for (auto& worker: workers_) {
+    Worker* w = worker.get();
+    w->thread_ = std::thread([w] { w->run(); });
+  }
+}
+
+
+void ReviewRetrier::stop()
+{
+  next_span_ = spans_.size();
+  for (auto& worker: workers_) {
+    worker->finder_->stop();
+  }
+}
+
+
+bool ReviewRetrier::finished() const
+{
+  return workers_running_ == 0;
+}
+
+
+double ReviewRetrier::get_progress() const
+{
+  if (total_frames_ == 0) {
+    return 1;
+  }
+  return std::min(1.0, (double) frames_done_ / total_frames_);
+}
+
+
+bool ReviewRetrier::pop_found_filter(found_filter& found)
+{
+  for (auto& worker: workers_) {
+    if (worker->found_filters_.pop(found)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+
+std::vector<std::string> ReviewRetrier::errors() const
+{
+  std::vector<std::string> errors;
+  for (const auto& worker: workers_) {
+    errors.insert(errors.end(), worker->errors_.begin(), worker->errors_.end());
+  }
+  return errors;
+}
+
+
+void ReviewRetrier::add_frames_done(int start_frame, int end_frame)
+{
+  frames_done_ += end_frame - start_frame + 1;
+  progress_dispatcher_.emit();
+}
+
+
+ReviewRetrier::Worker::Worker(ReviewRetrier& retrier)
+  : retrier_(retrier)
+{
+}
+
+
+void ReviewRetrier::Worker::run()
+{
+  while (true) {
+    std::size_t i = retrier_.next_span_++;
+    if (i >= retrier_.spans_.size()) {
+      break;
+    }
+
+    // The finder uses 0-based frames, with an exclusive end
+    const auto& span = retrier_.spans_[i];
+    finder_->set_start_frame(span.first - 1);
+    finder_->set_end_frame(span.second);
+    auto result = finder_->find_logos();
+    if (!result.first) {
+      errors_.push_back(result.second);
+    }
+  }
+
+  --retrier_.workers_running_;
+  retrier_.progress_dispatcher_.emit();
+}
+
+
+void ReviewRetrier::Worker::success(const mdl::LogoFinderResult& result)
+{
+  found_filters_.push(std::make_pair(result.start_frame + 1,
+                                     fg::filter_ptr(new fg::DelogoFilter(result.x, result.y,
+                                                                         result.width, result.height))));
+  retrier_.add_frames_done(result.start_frame, result.end_frame);
+}
+
+
+void ReviewRetrier::Worker::failure(int start_frame, int end_frame)
+{
+  found_filters_.push(std::make_pair(start_frame + 1, fg::filter_ptr(new fg::ReviewFilter())));
+  retrier_.add_frames_done(start_frame, end_frame);
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MDL_REVIEW_RETRIER_H
+#define MDL_REVIEW_RETRIER_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <utility>
+#include <functional>
+
+#include <glibmm/dispatcher.h>
+
+#include "filter-generator/Filters.hpp"
+
+#include "common/LogoFinder.hpp"
+
+#include "SPSCQueue.hpp"
+
+
+namespace mdl {
+  /**
+   * Searches for logos again only in the frames covered by review
+   * filters, spreading them among several threads, each with its own
+   * finder. Results are passed to the GUI thread through one queue
+   * per thread, and progress is signalled through a dispatcher.
+   */
+  class ReviewRetrier
+  {
+  public:
+    /** Start frame (1-based) and filter of each result */
+    typedef std::pair<int, fg::filter_ptr> found_filter;
+    typedef std::function<void(LogoFinder&)> configure_function;
+
+    /** spans are 1-based [first, last] */
+    ReviewRetrier(const std::string& movie_file,
+                  const std::vector<std::pair<int, int>>& spans,
+                  Glib::Dispatcher& progress_dispatcher,
+                  bool verbose);
+    ~ReviewRetrier();
+
+    ReviewRetrier(const ReviewRetrier&) = delete;
+    ReviewRetrier& operator=(const ReviewRetrier&) = delete;
+
+    /** configure is called for each finder before it is used */
+    void start(int n_threads, const configure_function& configure);
+    void stop();
+
+    bool finished() const;
+    /** Fraction of the frames in the spans already searched */
+    double get_progress() const;
+
+    /** Must only be called from the thread that created the retrier */
+    bool pop_found_filter(found_filter& found);
+
+    /**
+     * Why the searches that could not go through the whole span
+     * stopped. Must only be called once finished
+     */
+    std::vector<std::string> errors() const;
+
+  private:
+    class Worker : public LogoFinderCallback
+    {
+    public:
+      Worker(ReviewRetrier& retrier);
+
+      void success(const mdl::LogoFinderResult& result) override;
+      void failure(int start_frame, int end_frame) override;
+
+      void run();
+
+      std::shared_ptr<LogoFinder> finder_;
+      SPSCQueue<found_filter> found_filters_;
+      std::thread thread_;
+      // Only written by the worker thread, before it finishes
+      std::vector<std::string> errors_;
+
+    private:
+      ReviewRetrier& retrier_;
+    };
+
+    std::string movie_file_;
+    std::vector<std::pair<int, int>> spans_;
+    Glib::Dispatcher& progress_dispatcher_;
+    bool verbose_;
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    std::atomic<std::size_t> next_span_;
+    std::atomic<long> frames_done_;
+    std::atomic<int> workers_running_;
+    long total_frames_;
+
+
+    void add_frames_done(int start_frame, int end_frame);
+  };
+}
+
+#endif // MDL_REVIEW_RETRIER_H
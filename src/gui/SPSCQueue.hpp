@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MDL_SPSC_QUEUE_H
+#define MDL_SPSC_QUEUE_H
+
+#include <atomic>
+#include <utility>
+
+
+namespace mdl {
+  /**
+   * Unbounded queue for passing values from one producer thread to
+   * one consumer thread without locks. push() must only be called from
+   * the producer, and pop() only from the consumer. Items are kept in
+   * a linked list whose first node is a dummy, so the two threads
+   * never touch the same node except through its next pointer.
+   */
+  template <typename T>
+  class SPSCQueue
+  {
+  public:
+    SPSCQueue()
+      : head_(new Node())
+      , tail_(head_) { }
+
+    ~SPSCQueue() {
+      while (head_) {
+        Node* next = head_->next.load(std::memory_order_relaxed);
+        delete head_;
+        head_ = next;
+      }
+    }
+
+    SPSCQueue(const SPSCQueue&) = delete;
+    SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+
+    void push(T value) {
+      Node* node = new Node();
+      node->value = std::move(value);
+      tail_->next.store(node, std::memory_order_release);
+      tail_ = node;
+    }
+
+
+    /** Returns false if the queue is empty */
+    bool pop(T& value) {
+      Node* next = head_->next.load(std::memory_order_acquire);
+      if (!next) {
+        return false;
+      }
+
+      value = std::move(next->value);
+      delete head_;
+      head_ = next;
+      return true;
+    }
+
+  private:
+    struct Node
+    {
+      T value;
+      std::atomic<Node*> next{nullptr};
+    };
+
+    // Only used by the consumer
+    Node* head_;
+    // Only used by the producer
+    Node* tail_;
+  };
+}
+
+#endif // MDL_SPSC_QUEUE_H
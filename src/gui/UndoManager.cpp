@@ -28,7 +28,8 @@ using namespace mdl;
 
 
 UndoManager::UndoManager(Coordinator& coordinator)
-  : coordinator_(coordinator)
+  : in_transaction_(false)
+  , coordinator_(coordinator)
 {
 }
 
@@ -47,11 +48,42 @@ void UndoManager::execute_action(edit_action_ptr action)
 {
   clear_redo_list();
 
+  if (in_transaction_ && transaction_action_
+      && !undo_list_.empty() && undo_list_.front() == transaction_action_
+      && transaction_action_->merge(*action)) {
+    action->execute(coordinator_);
+    update_buttons();
+    return;
+  }
+
+  if (in_transaction_) {
+    transaction_action_ = action;
+  }
   add_to_undo_list(action);
   action->execute(coordinator_);
 }
 
 
+void UndoManager::begin_transaction()
+{
+  in_transaction_ = true;
+  transaction_action_ = nullptr;
+}
+
+
+void UndoManager::end_transaction()
+{
+  in_transaction_ = false;
+  transaction_action_ = nullptr;
+}
+
+
+bool UndoManager::in_transaction() const
+{
+  return in_transaction_;
+}
+
+
 void UndoManager::add_to_undo_list(edit_action_ptr action)
 {
   if (undo_list_.size() == UNDO_SIZE_) {
@@ -72,6 +104,7 @@ void UndoManager::clear_redo_list()
 
 void UndoManager::undo_last_action()
 {
+  end_transaction();
   if (undo_list_.empty()) {
     return;
   }
@@ -92,6 +125,7 @@ void UndoManager::move_to_redo_list(edit_action_ptr action)
 
 void UndoManager::redo_last_action()
 {
+  end_transaction();
   if (redo_list_.empty()) {
     return;
   }
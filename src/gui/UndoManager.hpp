@@ -41,12 +41,26 @@ namespace mdl {
     void undo_last_action();
     void redo_last_action();
 
+    /**
+     * Actions executed until end_transaction() are merged into the
+     * first one when possible, so that a continuous edit takes a
+     * single place in the undo list and is undone at once. Undoing
+     * or redoing ends the transaction.
+     */
+    void begin_transaction();
+    void end_transaction();
+    bool in_transaction() const;
+
   private:
     const static int UNDO_SIZE_ = 50;
 
     std::deque<edit_action_ptr> undo_list_;
     std::deque<edit_action_ptr> redo_list_;
 
+    bool in_transaction_;
+    // The action others in the transaction are merged into
+    edit_action_ptr transaction_action_;
+
     Coordinator& coordinator_;
     Gtk::Widget* btn_undo_;
     Gtk::Widget* btn_redo_;
@@ -19,6 +19,12 @@
 #ifndef MDL_LOGO_FINDER_H
 #define MDL_LOGO_FINDER_H
 
+#include <string>
+#include <memory>
+#include <limits>
+
+#include "LogoFinderStats.hpp"
+
 
 namespace mdl {
   class LogoFinderResult
@@ -57,6 +63,11 @@ namespace mdl {
       start_frame_ = start_frame;
     }
 
+    /** Frame after the last one to search */
+    void set_end_frame(int end_frame) {
+      end_frame_ = end_frame;
+    }
+
     void set_frame_interval_min(int frame_interval_min) {
       frame_interval_min_ = frame_interval_min;
     }
@@ -66,6 +77,74 @@ namespace mdl {
     }
 
 
+    /**
+     * Once a logo is found, follows it to the frame where it
+     * changes, instead of searching in the next interval again.
+     */
+    void set_tracking(bool tracking) {
+      tracking_ = tracking;
+    }
+
+
+    /**
+     * Searches more carefully: more subdivisions of each interval,
+     * more frames in each average, and a lower contrast threshold.
+     * Much slower, meant for retrying intervals where no logo was
+     * found.
+     */
+    void set_thorough(bool thorough) {
+      thorough_ = thorough;
+    }
+
+
+    /**
+     * Searches for logos only in the luma of the frames, instead of
+     * in each colour channel. Faster, but misses logos that differ
+     * from the background only in colour.
+     */
+    void set_luma(bool luma) {
+      luma_ = luma;
+    }
+
+
+    /**
+     * Searches for logos in a reduced copy of the average frame, and
+     * then only around the box found in the full size one. Makes the
+     * search in high resolution videos much faster.
+     */
+    void set_pyramid(bool pyramid) {
+      pyramid_ = pyramid;
+    }
+
+
+    /**
+     * Stops averaging frames as soon as the box found in the average
+     * doesn't change between two checkpoints.
+     */
+    void set_progressive(bool progressive) {
+      progressive_ = progressive;
+    }
+
+
+    /**
+     * Detects the shot changes in the video before searching, and
+     * looks for the end of logos only at them. The result is cached
+     * in a file next to the video.
+     */
+    void set_scene_detection(bool scene_detection) {
+      scene_detection_ = scene_detection;
+    }
+
+
+    /**
+     * File where logos found are saved, to be found faster in later
+     * searches. Empty disables it.
+     */
+    void set_template_file(const std::string& template_file) {
+      template_file_ = template_file;
+    }
+
+
     void set_verbose(bool verbose = true) {
       verbose_ = verbose;
     }
@@ -104,6 +183,15 @@ namespace mdl {
     }
 
 
+    /**
+     * Statistics of the last search. Must only be read after
+     * find_logos() returns.
+     */
+    const LogoFinderStats& stats() const {
+      return stats_;
+    }
+
+
     typedef std::pair<bool, std::string> find_result;
 
 
@@ -112,9 +200,19 @@ namespace mdl {
 
   protected:
     int start_frame_;
+    int end_frame_ = std::numeric_limits<int>::max();
     int frame_interval_min_;
     int extra_frames_;
 
+    bool tracking_ = false;
+    bool scene_detection_ = false;
+    bool progressive_ = false;
+    bool pyramid_ = false;
+    bool luma_ = false;
+    bool thorough_ = false;
+
+    std::string template_file_;
+
     bool verbose_ = false;
 
     /**
@@ -134,9 +232,19 @@ namespace mdl {
      */
     int max_logo_height_ = 23;
 
+    LogoFinderStats stats_;
+
 
     LogoFinderCallback& callback_;
   };
+
+
+  /**
+   * Creates a finder that only reports the logos found to callback,
+   * from the thread running find_logos().
+   */
+  std::shared_ptr<LogoFinder> create_logo_finder(const std::string& movie_file,
+                                                 LogoFinderCallback& callback, bool verbose);
 }
 
 
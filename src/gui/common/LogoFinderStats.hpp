@@ -0,0 +1,193 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MDL_LOGO_FINDER_STATS_H
+#define MDL_LOGO_FINDER_STATS_H
+
+#include <array>
+#include <chrono>
+#include <ostream>
+
+
+namespace mdl {
+  /**
+   * Counters collected by a LogoFinder while it searches: time spent
+   * in each stage, with a histogram of call durations, and how many
+   * frames were decoded, used and how many seeks were done.
+   */
+  class LogoFinderStats
+  {
+  public:
+    enum class Stage { SEEK, DECODE, RETRIEVE, AVERAGE, SHARPEN, MORPHOLOGY, CONTOURS, COMPARE, MATCH, SCENES };
+    static const int N_STAGES_ = 10;
+
+    /**
+     * Bucket i of the histogram counts calls that took less than
+     * 2^i microseconds. The last one counts all the slower calls.
+     */
+    static const int N_BUCKETS_ = 20;
+
+    typedef std::chrono::steady_clock Clock;
+
+    class StageStats
+    {
+    public:
+      long calls = 0;
+      std::chrono::nanoseconds total{0};
+      std::chrono::nanoseconds max{0};
+      std::array<long, N_BUCKETS_> histogram{};
+    };
+
+
+    /** Adds the time elapsed while it exists to a stage */
+    class Timer
+    {
+    public:
+      Timer(LogoFinderStats& stats, Stage stage)
+        : stats_(stats)
+        , stage_(stage)
+        , start_(Clock::now()) { }
+
+      ~Timer() {
+        stats_.add(stage_, Clock::now() - start_);
+      }
+
+      Timer(const Timer&) = delete;
+      Timer& operator=(const Timer&) = delete;
+
+    private:
+      LogoFinderStats& stats_;
+      Stage stage_;
+      Clock::time_point start_;
+    };
+
+
+    void reset() {
+      *this = LogoFinderStats();
+    }
+
+
+    void add(Stage stage, std::chrono::nanoseconds elapsed) {
+      StageStats& s = stages_[static_cast<int>(stage)];
+      ++s.calls;
+      s.total += elapsed;
+      if (elapsed > s.max) {
+        s.max = elapsed;
+      }
+
+      long us = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+      int bucket = 0;
+      while (bucket < N_BUCKETS_ - 1 && us >= (1L << bucket)) {
+        ++bucket;
+      }
+      ++s.histogram[bucket];
+    }
+
+    const StageStats& get(Stage stage) const {
+      return stages_[static_cast<int>(stage)];
+    }
+
+
+    void count_seek() {
+      ++seeks_;
+    }
+
+    void count_decoded_frame() {
+      ++frames_decoded_;
+    }
+
+    void count_used_frame() {
+      ++frames_used_;
+    }
+
+    /** Frames not averaged because the box found had converged */
+    void count_skipped_frames(long frames) {
+      frames_skipped_ += frames;
+    }
+
+    long seeks() const {
+      return seeks_;
+    }
+
+    long frames_decoded() const {
+      return frames_decoded_;
+    }
+
+    long frames_used() const {
+      return frames_used_;
+    }
+
+    long frames_skipped() const {
+      return frames_skipped_;
+    }
+
+
+    static const char* stage_name(Stage stage) {
+      static const char* names[N_STAGES_] = {
+        "seek", "decode", "retrieve", "average", "sharpen", "morphology", "contours", "compare", "match", "scenes"
+      };
+      return names[static_cast<int>(stage)];
+    }
+
+
+    void write_json(std::ostream& out) const {
+      out << "{\n"
+          << "  \"seeks\": " << seeks_ << ",\n"
+          << "  \"frames_decoded\": " << frames_decoded_ << ",\n"
+          << "  \"frames_used\": " << frames_used_ << ",\n"
+          << "  \"frames_skipped\": " << frames_skipped_ << ",\n";
+
+      out << "  \"histogram_bucket_us\": [";
+      for (int i = 0; i < N_BUCKETS_ - 1; ++i) {
+        out << (i ? ", " : "") << (1L << i);
+      }
+      out << "],\n";
+
+      out << "  \"stages\": {\n";
+      for (int i = 0; i < N_STAGES_; ++i) {
+        const StageStats& s = stages_[i];
+        out << "    \"" << stage_name(static_cast<Stage>(i)) << "\": {"
+            << "\"calls\": " << s.calls << ", "
+            << "\"total_ms\": " << to_ms(s.total) << ", "
+            << "\"max_ms\": " << to_ms(s.max) << ", "
+            << "\"histogram\": [";
+        for (int b = 0; b < N_BUCKETS_; ++b) {
+          out << (b ? ", " : "") << s.histogram[b];
+        }
+        out << "]}" << (i < N_STAGES_ - 1 ? "," : "") << "\n";
+      }
+      out << "  }\n"
+          << "}\n";
+    }
+
+  private:
+    std::array<StageStats, N_STAGES_> stages_;
+    long seeks_ = 0;
+    long frames_decoded_ = 0;
+    long frames_used_ = 0;
+    long frames_skipped_ = 0;
+
+
+    static double to_ms(std::chrono::nanoseconds time) {
+      return std::chrono::duration<double, std::milli>(time).count();
+    }
+  };
+}
+
+
+#endif // MDL_LOGO_FINDER_STATS_H
@@ -0,0 +1,231 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <cstdint>
+
+extern "C" {
+#include <libavformat/avformat.h>
+#include <libavcodec/avcodec.h>
+#include <libavutil/frame.h>
+#include <libavutil/mathematics.h>
+#include <libswscale/swscale.h>
+}
+
+#include "gui/common/Exceptions.hpp"
+
+#include "LibavFrameSource.hpp"
+
+using namespace mdl::libav;
+
+
+LibavFrameSource::LibavFrameSource(const std::string& file, int threads)
+  : format_(nullptr)
+  , codec_(nullptr)
+  , packet_(nullptr)
+  , frame_(nullptr)
+  , sws_(nullptr)
+  , position_(0)
+  , eof_(false)
+  , pending_(false)
+{
+  if (avformat_open_input(&format_, file.c_str(), nullptr, nullptr) != 0) {
+    throw mdl::VideoNotOpenedException();
+  }
+
+  if (avformat_find_stream_info(format_, nullptr) < 0) {
+    close();
+    throw mdl::VideoNotOpenedException();
+  }
+
+  stream_index_ = av_find_best_stream(format_, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+  if (stream_index_ < 0) {
+    close();
+    throw mdl::VideoNotOpenedException();
+  }
+  AVStream* stream = format_->streams[stream_index_];
+
+  const AVCodec* decoder = avcodec_find_decoder(stream->codecpar->codec_id);
+  codec_ = avcodec_alloc_context3(decoder);
+  if (!decoder || !codec_ || avcodec_parameters_to_context(codec_, stream->codecpar) < 0) {
+    close();
+    throw mdl::VideoNotOpenedException();
+  }
+
+  codec_->thread_count = threads;
+  codec_->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+  if (avcodec_open2(codec_, decoder, nullptr) < 0) {
+    close();
+    throw mdl::VideoNotOpenedException();
+  }
+
+  packet_ = av_packet_alloc();
+  frame_ = av_frame_alloc();
+
+  time_base_ = stream->time_base;
+  frame_rate_ = av_guess_frame_rate(format_, stream, nullptr);
+  start_pts_ = stream->start_time == AV_NOPTS_VALUE ? 0 : stream->start_time;
+
+  if (stream->nb_frames > 0) {
+    number_of_frames_ = stream->nb_frames;
+  } else {
+    number_of_frames_ = av_rescale(format_->duration, frame_rate_.num,
+                                   (int64_t) frame_rate_.den * AV_TIME_BASE);
+  }
+}
+
+
+LibavFrameSource::~LibavFrameSource()
+{
+  close();
+}
+
+
+void LibavFrameSource::close()
+{
+  sws_freeContext(sws_);
+  sws_ = nullptr;
+  av_frame_free(&frame_);
+  av_packet_free(&packet_);
+  avcodec_free_context(&codec_);
+  avformat_close_input(&format_);
+}
+
+
+/**
+ * Seeks to the keyframe before the frame, and decodes until reaching
+ * it, so that the position is exact even in videos with long GOPs.
+ */
+void LibavFrameSource::seek(int frame_number)
+{
+  if (frame_number == position_) {
+    return;
+  }
+
+  if (av_seek_frame(format_, stream_index_, frame_to_pts(frame_number), AVSEEK_FLAG_BACKWARD) < 0) {
+    throw mdl::FrameNotAvailableException(frame_number);
+  }
+  avcodec_flush_buffers(codec_);
+  eof_ = false;
+  pending_ = false;
+
+  while (decode_next()) {
+    if (frame_->best_effort_timestamp == AV_NOPTS_VALUE
+        || pts_to_frame(frame_->best_effort_timestamp) >= frame_number) {
+      pending_ = true;
+      break;
+    }
+  }
+
+  position_ = frame_number;
+}
+
+
+const AVFrame* LibavFrameSource::read()
+{
+  if (pending_) {
+    pending_ = false;
+  } else if (!decode_next()) {
+    return nullptr;
+  }
+
+  ++position_;
+  return frame_;
+}
+
+
+bool LibavFrameSource::decode_next()
+{
+  av_frame_unref(frame_);
+
+  while (true) {
+    int ret = avcodec_receive_frame(codec_, frame_);
+    if (ret == 0) {
+      return true;
+    }
+    if (ret != AVERROR(EAGAIN) || eof_) {
+      return false;
+    }
+
+    if (av_read_frame(format_, packet_) < 0) {
+      // Drain the frames still in the decoder
+      avcodec_send_packet(codec_, nullptr);
+      eof_ = true;
+      continue;
+    }
+    if (packet_->stream_index == stream_index_) {
+      avcodec_send_packet(codec_, packet_);
+    }
+    av_packet_unref(packet_);
+  }
+}
+
+
+void LibavFrameSource::convert(const AVFrame* frame, AVPixelFormat format, uint8_t* data, int linesize)
+{
+  sws_ = sws_getCachedContext(sws_,
+                              frame->width, frame->height, static_cast<AVPixelFormat>(frame->format),
+                              frame->width, frame->height, format,
+                              SWS_BILINEAR, nullptr, nullptr, nullptr);
+
+  uint8_t* dst[4] = {data, nullptr, nullptr, nullptr};
+  int dst_linesize[4] = {linesize, 0, 0, 0};
+  sws_scale(sws_, frame->data, frame->linesize, 0, frame->height, dst, dst_linesize);
+}
+
+
+int LibavFrameSource::get_frame_width() const
+{
+  return codec_->width;
+}
+
+
+int LibavFrameSource::get_frame_height() const
+{
+  return codec_->height;
+}
+
+
+int LibavFrameSource::get_number_of_frames() const
+{
+  return number_of_frames_;
+}
+
+
+double LibavFrameSource::get_fps() const
+{
+  return av_q2d(frame_rate_);
+}
+
+
+int LibavFrameSource::get_position() const
+{
+  return position_;
+}
+
+
+int64_t LibavFrameSource::frame_to_pts(int frame_number) const
+{
+  return start_pts_ + av_rescale_q(frame_number, av_inv_q(frame_rate_), time_base_);
+}
+
+
+int LibavFrameSource::pts_to_frame(int64_t pts) const
+{
+  return av_rescale_q(pts - start_pts_, time_base_, av_inv_q(frame_rate_));
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MDL_LIBAV_FRAME_SOURCE_H
+#define MDL_LIBAV_FRAME_SOURCE_H
+
+#include <string>
+#include <cstdint>
+
+extern "C" {
+#include <libavformat/avformat.h>
+#include <libavcodec/avcodec.h>
+#include <libavutil/frame.h>
+#include <libswscale/swscale.h>
+}
+
+
+namespace mdl { namespace libav {
+  /**
+   * Decodes a video directly with libavformat and libavcodec. The
+   * decoder uses frame and slice threads, seeking is frame accurate,
+   * and frames are returned as decoded, without any conversion or
+   * copy. They can be converted to any pixel format with convert().
+   */
+  class LibavFrameSource
+  {
+  public:
+    /** threads is the number of decoding threads, 0 for automatic */
+    explicit LibavFrameSource(const std::string& file, int threads = 0);
+    ~LibavFrameSource();
+
+    LibavFrameSource(const LibavFrameSource&) = delete;
+    LibavFrameSource& operator=(const LibavFrameSource&) = delete;
+
+    /** Makes frame_number the next frame returned by read() */
+    void seek(int frame_number);
+
+    /**
+     * Decodes the next frame, returning nullptr at the end of the
+     * video. The frame belongs to the source and is only valid until
+     * the next call; use av_frame_ref() to keep its buffers.
+     */
+    const AVFrame* read();
+
+    /** Converts frame into a width x height image in data */
+    void convert(const AVFrame* frame, AVPixelFormat format, uint8_t* data, int linesize);
+
+    int get_frame_width() const;
+    int get_frame_height() const;
+    int get_number_of_frames() const;
+    double get_fps() const;
+    /** Number of the next frame that read() returns */
+    int get_position() const;
+
+  private:
+    AVFormatContext* format_;
+    AVCodecContext* codec_;
+    AVPacket* packet_;
+    AVFrame* frame_;
+    SwsContext* sws_;
+
+    int stream_index_;
+    AVRational time_base_;
+    AVRational frame_rate_;
+    int64_t start_pts_;
+    int number_of_frames_;
+
+    int position_;
+    bool eof_;
+    // seek() decodes the frame it seeks to, which read() then returns
+    bool pending_;
+
+    bool decode_next();
+    int64_t frame_to_pts(int frame_number) const;
+    int pts_to_frame(int64_t pts) const;
+    void close();
+  };
+} }
+
+
+#endif // MDL_LIBAV_FRAME_SOURCE_H
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+
+#include <opencv2/core.hpp>
+#include <opencv2/videoio.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include "gui/common/Exceptions.hpp"
+
+#include "CaptureVideoSource.hpp"
+
+using namespace mdl::opencv;
+
+
+CaptureVideoSource::CaptureVideoSource(const std::string& file)
+{
+  cap_.open(file);
+  if (!cap_.isOpened()) {
+    throw mdl::VideoNotOpenedException();
+  }
+}
+
+
+void CaptureVideoSource::seek(int frame_number)
+{
+  cap_.set(cv::CAP_PROP_POS_FRAMES, frame_number);
+}
+
+
+bool CaptureVideoSource::grab()
+{
+  return cap_.grab();
+}
+
+
+bool CaptureVideoSource::retrieve(cv::Mat& frame)
+{
+  return cap_.retrieve(frame);
+}
+
+
+bool CaptureVideoSource::retrieve_luma(cv::Mat& luma)
+{
+  if (!cap_.retrieve(bgr_)) {
+    return false;
+  }
+  cv::cvtColor(bgr_, luma, cv::COLOR_BGR2GRAY);
+  return true;
+}
+
+
+int CaptureVideoSource::get_frame_width()
+{
+  return cap_.get(cv::CAP_PROP_FRAME_WIDTH);
+}
+
+
+int CaptureVideoSource::get_frame_height()
+{
+  return cap_.get(cv::CAP_PROP_FRAME_HEIGHT);
+}
+
+
+int CaptureVideoSource::get_number_of_frames()
+{
+  return cap_.get(cv::CAP_PROP_FRAME_COUNT);
+}
+
+
+double CaptureVideoSource::get_fps()
+{
+  return cap_.get(cv::CAP_PROP_FPS);
+}
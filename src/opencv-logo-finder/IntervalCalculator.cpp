@@ -18,6 +18,8 @@
  */
 #include <vector>
 #include <utility>
+#include <algorithm>
+#include <functional>
 
 #include "IntervalCalculator.hpp"
 
@@ -39,6 +41,45 @@ std::vector<std::pair<int, int>> IntervalCalculator::get_subintervals(int interv
 }
 
 
+int IntervalCalculator::find_transition(int present_frame, int end_frame, int step, int max_step,
+                                        const std::function<bool(int)>& is_present)
+{
+  int present = present_frame;
+  int absent = end_frame;
+
+  while (present < end_frame - 1) {
+    int frame = std::min(present + step, end_frame - 1);
+    if (!is_present(frame)) {
+      absent = frame;
+      break;
+    }
+    present = frame;
+    step = std::min(step * 2, std::max(max_step, step));
+  }
+
+  while (absent - present > 1) {
+    int middle = present + (absent - present) / 2;
+    if (is_present(middle)) {
+      present = middle;
+    } else {
+      absent = middle;
+    }
+  }
+
+  return absent;
+}
+
+
+int IntervalCalculator::count_samples(int interval_start, int interval_end, int step)
+{
+  int first = ((std::max(interval_start, 0) + step - 1) / step) * step;
+  if (first >= interval_end) {
+    return 0;
+  }
+  return (interval_end - 1 - first) / step + 1;
+}
+
+
 void IntervalCalculator::adjust_last_subinterval(std::vector<std::pair<int, int>>& subintervals, int interval_end)
 {
   subintervals.back().second = interval_end;
@@ -21,6 +21,7 @@
 
 #include <vector>
 #include <utility>
+#include <functional>
 
 
 namespace mdl { namespace opencv {
@@ -29,6 +30,24 @@ namespace mdl { namespace opencv {
   public:
     static std::vector<std::pair<int, int>> get_subintervals(int interval_start, int interval_end, int n_subintervals);
 
+    /**
+     * Finds the first frame, after present_frame and before
+     * end_frame, for which is_present returns false, assuming it
+     * returns true until some frame and false after it. Frames are
+     * checked ahead with a step that doubles up to max_step, and then
+     * the transition is found by bisection. Returns end_frame if
+     * there is no transition.
+     */
+    static int find_transition(int present_frame, int end_frame, int step, int max_step,
+                               const std::function<bool(int)>& is_present);
+
+    /**
+     * Number of frames f, interval_start <= f < interval_end, that
+     * are multiples of step, which are the ones used to calculate an
+     * average.
+     */
+    static int count_samples(int interval_start, int interval_end, int step);
+
   private:
     static void adjust_last_subinterval(std::vector<std::pair<int, int>>& subintervals, int interval_end);
   };
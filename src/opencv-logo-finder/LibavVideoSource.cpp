@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+
+#include <opencv2/core.hpp>
+
+extern "C" {
+#include <libavutil/pixdesc.h>
+}
+
+#include "libav-frame-source/LibavFrameSource.hpp"
+
+#include "VideoSource.hpp"
+#include "LibavVideoSource.hpp"
+
+using namespace mdl::opencv;
+
+
+LibavVideoSource::LibavVideoSource(const std::string& file)
+  : source_(file)
+  , frame_(nullptr)
+{
+}
+
+
+void LibavVideoSource::seek(int frame_number)
+{
+  source_.seek(frame_number);
+}
+
+
+bool LibavVideoSource::grab()
+{
+  frame_ = source_.read();
+  return frame_ != nullptr;
+}
+
+
+bool LibavVideoSource::retrieve(cv::Mat& frame)
+{
+  if (!frame_) {
+    return false;
+  }
+
+  frame.create(frame_->height, frame_->width, CV_8UC3);
+  source_.convert(frame_, AV_PIX_FMT_BGR24, frame.data, frame.step);
+  return true;
+}
+
+
+bool LibavVideoSource::retrieve_luma(cv::Mat& luma)
+{
+  if (!frame_) {
+    return false;
+  }
+
+  if (has_luma_plane()) {
+    luma = cv::Mat(frame_->height, frame_->width, CV_8UC1, frame_->data[0], frame_->linesize[0]);
+    return true;
+  }
+
+  luma_.create(frame_->height, frame_->width, CV_8UC1);
+  source_.convert(frame_, AV_PIX_FMT_GRAY8, luma_.data, luma_.step);
+  luma = luma_;
+  return true;
+}
+
+
+/**
+ * True for 8 bit YUV formats where the first plane has only the
+ * luma, one byte per pixel.
+ */
+bool LibavVideoSource::has_luma_plane() const
+{
+  const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get(static_cast<AVPixelFormat>(frame_->format));
+  return desc
+    && !(desc->flags & AV_PIX_FMT_FLAG_RGB)
+    && (desc->flags & AV_PIX_FMT_FLAG_PLANAR)
+    && desc->comp[0].plane == 0
+    && desc->comp[0].step == 1
+    && desc->comp[0].depth == 8;
+}
+
+
+int LibavVideoSource::get_frame_width()
+{
+  return source_.get_frame_width();
+}
+
+
+int LibavVideoSource::get_frame_height()
+{
+  return source_.get_frame_height();
+}
+
+
+int LibavVideoSource::get_number_of_frames()
+{
+  return source_.get_number_of_frames();
+}
+
+
+double LibavVideoSource::get_fps()
+{
+  return source_.get_fps();
+}
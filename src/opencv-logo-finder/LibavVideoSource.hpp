@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MDL_OPENCV_LIBAV_VIDEO_SOURCE_H
+#define MDL_OPENCV_LIBAV_VIDEO_SOURCE_H
+
+#include <string>
+
+#include <opencv2/core.hpp>
+
+#include "libav-frame-source/LibavFrameSource.hpp"
+
+#include "VideoSource.hpp"
+
+
+namespace mdl { namespace opencv {
+  /**
+   * Reads frames with libav. The luma of planar YUV frames is used
+   * directly from the decoder memory, without any conversion.
+   */
+  class LibavVideoSource : public VideoSource
+  {
+  public:
+    explicit LibavVideoSource(const std::string& file);
+
+    void seek(int frame_number) override;
+    bool grab() override;
+    bool retrieve(cv::Mat& frame) override;
+    bool retrieve_luma(cv::Mat& luma) override;
+
+    int get_frame_width() override;
+    int get_frame_height() override;
+    int get_number_of_frames() override;
+    double get_fps() override;
+
+  private:
+    mdl::libav::LibavFrameSource source_;
+    const AVFrame* frame_;
+    // Used only for frames whose first plane is not the luma
+    cv::Mat luma_;
+
+    bool has_luma_plane() const;
+  };
+} }
+
+
+#endif // MDL_OPENCV_LIBAV_VIDEO_SOURCE_H
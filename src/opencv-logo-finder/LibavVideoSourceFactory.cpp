@@ -0,0 +1,33 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <memory>
+
+#include "VideoSource.hpp"
+#include "LibavVideoSource.hpp"
+#include "Y4MVideoSource.hpp"
+
+
+std::unique_ptr<mdl::opencv::VideoSource> mdl::opencv::open_video_source(const std::string& file)
+{
+  if (mdl::opencv::Y4MVideoSource::is_y4m_file(file)) {
+    return std::unique_ptr<mdl::opencv::VideoSource>(new mdl::opencv::Y4MVideoSource(file));
+  }
+  return std::unique_ptr<mdl::opencv::VideoSource>(new mdl::opencv::LibavVideoSource(file));
+}
@@ -16,6 +16,7 @@
  * You should have received a copy of the GNU General Public License
  * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
  */
+#include <string>
 #include <memory>
 
 #include "filter-generator/FilterData.hpp"
@@ -36,3 +37,9 @@ std::shared_ptr<mdl::LogoFinder> mdl::create_logo_finder(fg::FilterData& filter_
       delete adapter;
     });
 }
+
+
+std::shared_ptr<mdl::LogoFinder> mdl::create_logo_finder(const std::string& movie_file, mdl::LogoFinderCallback& callback, bool verbose)
+{
+  return std::make_shared<mdl::opencv::OpenCVLogoFinder>(movie_file, callback, verbose);
+}
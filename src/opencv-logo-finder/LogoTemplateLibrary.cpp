@@ -0,0 +1,233 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include "LogoTemplateLibrary.hpp"
+
+using namespace mdl::opencv;
+
+
+LogoTemplateLibrary::LogoTemplateLibrary()
+  : modified_(false)
+{
+}
+
+
+bool LogoTemplateLibrary::load(const std::string& file)
+{
+  templates_.clear();
+  modified_ = false;
+
+  try {
+    cv::FileStorage fs(file, cv::FileStorage::READ);
+    if (!fs.isOpened()) {
+      return false;
+    }
+
+    cv::FileNode nodes = fs["templates"];
+    for (const auto& node: nodes) {
+      Template tmpl;
+      tmpl.position.x = (int) node["x"];
+      tmpl.position.y = (int) node["y"];
+      tmpl.position.width = (int) node["width"];
+      tmpl.position.height = (int) node["height"];
+      tmpl.matches = (int) node["matches"];
+      tmpl.added = false;
+      node["image"] >> tmpl.image;
+
+      if (tmpl.image.rows != tmpl.position.height || tmpl.image.cols != tmpl.position.width) {
+        templates_.clear();
+        return false;
+      }
+      templates_.push_back(tmpl);
+    }
+  } catch (const cv::Exception& e) {
+    templates_.clear();
+    return false;
+  }
+
+  sort_by_matches();
+  return true;
+}
+
+
+bool LogoTemplateLibrary::save(const std::string& file) const
+{
+  try {
+    cv::FileStorage fs(file, cv::FileStorage::WRITE);
+    if (!fs.isOpened()) {
+      return false;
+    }
+
+    fs << "templates" << "[";
+    for (const auto& tmpl: templates_) {
+      fs << "{"
+         << "x" << tmpl.position.x
+         << "y" << tmpl.position.y
+         << "width" << tmpl.position.width
+         << "height" << tmpl.position.height
+         << "matches" << tmpl.matches
+         << "image" << tmpl.image
+         << "}";
+    }
+    fs << "]";
+  } catch (const cv::Exception& e) {
+    return false;
+  }
+
+  return true;
+}
+
+
+bool LogoTemplateLibrary::empty() const
+{
+  return templates_.empty();
+}
+
+
+std::size_t LogoTemplateLibrary::size() const
+{
+  return templates_.size();
+}
+
+
+bool LogoTemplateLibrary::modified() const
+{
+  return modified_;
+}
+
+
+void LogoTemplateLibrary::add(const cv::Mat& frame, const cv::Rect& position)
+{
+  cv::Mat crop(frame, position);
+  Template tmpl;
+  tmpl.position = position;
+  tmpl.matches = 1;
+  tmpl.added = true;
+  if (crop.channels() == 3) {
+    cv::cvtColor(crop, tmpl.image, cv::COLOR_BGR2GRAY);
+  } else {
+    tmpl.image = crop.clone();
+  }
+
+  modified_ = true;
+
+  for (auto& existing: templates_) {
+    if (existing.position.width != position.width || existing.position.height != position.height) {
+      continue;
+    }
+    if (std::abs(existing.position.x - position.x) > search_margin_
+        || std::abs(existing.position.y - position.y) > search_margin_) {
+      continue;
+    }
+
+    cv::Point location;
+    if (correlation(tmpl.image, existing, location) >= match_threshold_) {
+      // Found again in the same search, probably in the same video,
+      // which doesn't make it more likely to be a logo
+      if (!existing.added) {
+        existing.added = true;
+        ++existing.matches;
+        sort_by_matches();
+      }
+      return;
+    }
+  }
+
+  // The ones matched less often are replaced first. A new template
+  // is kept as a candidate even if it matched only once, since it was
+  // just seen.
+  if (templates_.size() >= (std::size_t) MAX_TEMPLATES_) {
+    templates_.pop_back();
+  }
+  templates_.push_back(tmpl);
+  sort_by_matches();
+}
+
+
+int LogoTemplateLibrary::match(const cv::Mat& grey_frame, cv::Rect& position)
+{
+  cv::Rect frame_rect(0, 0, grey_frame.cols, grey_frame.rows);
+
+  int best = -1;
+  double best_score = match_threshold_;
+  for (std::size_t i = 0; i < templates_.size(); ++i) {
+    const Template& tmpl = templates_[i];
+    if (tmpl.matches < MIN_DETECTIONS_) {
+      // Sorted by matches, so the rest are candidates too
+      break;
+    }
+
+    cv::Rect roi(tmpl.position.x - search_margin_, tmpl.position.y - search_margin_,
+                 tmpl.position.width + 2*search_margin_, tmpl.position.height + 2*search_margin_);
+    roi &= frame_rect;
+    if (roi.width < tmpl.position.width || roi.height < tmpl.position.height) {
+      continue;
+    }
+
+    cv::Point location;
+    double score = correlation(cv::Mat(grey_frame, roi), tmpl, location);
+    if (score >= best_score) {
+      best = i;
+      best_score = score;
+      position = cv::Rect(roi.x + location.x, roi.y + location.y,
+                          tmpl.position.width, tmpl.position.height);
+    }
+  }
+
+  return best;
+}
+
+
+const cv::Mat& LogoTemplateLibrary::image(int index) const
+{
+  return templates_[index].image;
+}
+
+
+void LogoTemplateLibrary::count_match(int index)
+{
+  ++templates_[index].matches;
+  modified_ = true;
+  sort_by_matches();
+}
+
+
+double LogoTemplateLibrary::correlation(const cv::Mat& image, const Template& tmpl, cv::Point& location)
+{
+  double max;
+  cv::matchTemplate(image, tmpl.image, t_result_, cv::TM_CCOEFF_NORMED);
+  cv::minMaxLoc(t_result_, nullptr, &max, nullptr, &location);
+  return max;
+}
+
+
+void LogoTemplateLibrary::sort_by_matches()
+{
+  std::stable_sort(templates_.begin(), templates_.end(),
+    [](const Template& t1, const Template& t2) {
+      return t1.matches > t2.matches;
+    });
+}
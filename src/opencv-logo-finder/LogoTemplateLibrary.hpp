@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MDL_LOGO_TEMPLATE_LIBRARY_H
+#define MDL_LOGO_TEMPLATE_LIBRARY_H
+
+#include <string>
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+
+namespace mdl { namespace opencv {
+  /**
+   * Logos found in previous searches, with their positions. Videos
+   * from the same channel usually have the same logo in the same
+   * place, so it is much faster to look for a known logo in a few
+   * frames than to find it again by averaging the frames.
+   *
+   * Templates are kept in greyscale. The ones that matched more
+   * often are tried first. A logo must be found by averaging in
+   * MIN_DETECTIONS_ searches before its template is tried, so that a
+   * box found by mistake doesn't make later searches wrong.
+   */
+  class LogoTemplateLibrary
+  {
+  public:
+    static const int MAX_TEMPLATES_ = 64;
+    static const int MIN_DETECTIONS_ = 3;
+
+    LogoTemplateLibrary();
+
+    /**
+     * Loads the templates saved in a file. Returns false if the file
+     * doesn't exist or is invalid, leaving the library empty.
+     */
+    bool load(const std::string& file);
+    bool save(const std::string& file) const;
+
+    bool empty() const;
+    std::size_t size() const;
+    /** Whether templates were added or matched since it was loaded */
+    bool modified() const;
+
+    /**
+     * Adds a logo, cropped from the frame at the given position. If
+     * there is already an equal template at the same position, only
+     * its count of matches is incremented, once after each load().
+     * New templates are only candidates, not used by match(), until
+     * added in MIN_DETECTIONS_ searches.
+     */
+    void add(const cv::Mat& frame, const cv::Rect& position);
+
+    /**
+     * Searches the confirmed templates near their positions in a
+     * greyscale frame. Returns the index of the template with the
+     * best match above the threshold, or -1, and where it was found.
+     */
+    int match(const cv::Mat& grey_frame, cv::Rect& position);
+
+    /** Greyscale image of a template */
+    const cv::Mat& image(int index) const;
+
+    /** Counts a match of a template, so that it is tried earlier */
+    void count_match(int index);
+
+    /**
+     * Pixels around the saved position of a template where it is
+     * searched, in case the logo moved slightly.
+     */
+    int search_margin_ = 8;
+    /**
+     * Minimal normalized correlation for a template to match. Lower
+     * finds logos with a busier background, but can also match
+     * frames where the logo is not present.
+     */
+    double match_threshold_ = 0.8;
+
+  private:
+    class Template
+    {
+    public:
+      cv::Rect position;
+      cv::Mat image;
+      int matches;
+      /** Whether it was added since the library was loaded */
+      bool added;
+    };
+
+    std::vector<Template> templates_;
+    bool modified_;
+
+    // Temporary variable, allocated only once
+    cv::Mat t_result_;
+
+
+    double correlation(const cv::Mat& image, const Template& tmpl, cv::Point& location);
+    void sort_by_matches();
+  };
+} }
+
+
+#endif // MDL_LOGO_TEMPLATE_LIBRARY_H
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstddef>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "gui/common/Exceptions.hpp"
+
+#include "MappedFile.hpp"
+
+using namespace mdl::opencv;
+
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& file)
+  : data_(nullptr)
+  , size_(0)
+  , mapping_(nullptr)
+{
+  HANDLE handle = CreateFileA(file.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (handle == INVALID_HANDLE_VALUE) {
+    throw VideoNotOpenedException();
+  }
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(handle, &size) || size.QuadPart == 0) {
+    CloseHandle(handle);
+    throw VideoNotOpenedException();
+  }
+  size_ = size.QuadPart;
+
+  // The mapping keeps the file open
+  mapping_ = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(handle);
+  if (!mapping_) {
+    throw VideoNotOpenedException();
+  }
+
+  data_ = static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+  if (!data_) {
+    CloseHandle(mapping_);
+    throw VideoNotOpenedException();
+  }
+}
+
+
+MappedFile::~MappedFile()
+{
+  UnmapViewOfFile(data_);
+  CloseHandle(mapping_);
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& file)
+  : data_(nullptr)
+  , size_(0)
+{
+  int fd = open(file.c_str(), O_RDONLY);
+  if (fd == -1) {
+    throw VideoNotOpenedException();
+  }
+
+  struct stat info;
+  if (fstat(fd, &info) == -1 || info.st_size == 0) {
+    close(fd);
+    throw VideoNotOpenedException();
+  }
+  size_ = info.st_size;
+
+  // The mapping stays valid after the file is closed
+  void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    throw VideoNotOpenedException();
+  }
+
+  // Frames are mostly read in order
+  madvise(data, size_, MADV_SEQUENTIAL);
+  data_ = static_cast<const char*>(data);
+}
+
+
+MappedFile::~MappedFile()
+{
+  munmap(const_cast<char*>(data_), size_);
+}
+
+#endif
+
+
+const char* MappedFile::data() const
+{
+  return data_;
+}
+
+
+std::size_t MappedFile::size() const
+{
+  return size_;
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MDL_OPENCV_MAPPED_FILE_H
+#define MDL_OPENCV_MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+
+namespace mdl { namespace opencv {
+  /** A file mapped read-only into memory */
+  class MappedFile
+  {
+  public:
+    /** Throws VideoNotOpenedException */
+    explicit MappedFile(const std::string& file);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const;
+    std::size_t size() const;
+
+  private:
+    const char* data_;
+    std::size_t size_;
+#ifdef _WIN32
+    void* mapping_;
+#endif
+  };
+} }
+
+
+#endif // MDL_OPENCV_MAPPED_FILE_H
@@ -16,21 +16,28 @@
  * You should have received a copy of the GNU General Public License
  * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
  */
+#include <cstdlib>
 #include <string>
 #include <vector>
 #include <utility>
 #include <algorithm>
 #include <iostream>
+#include <fstream>
 
-#include <opencv2/videoio.hpp>
 #include <opencv2/imgproc.hpp>
 
 #include "gui/common/Exceptions.hpp"
+#include "gui/common/LogoFinderStats.hpp"
 
 #include "OpenCVLogoFinder.hpp"
 #include "IntervalCalculator.hpp"
+#include "LogoTemplateLibrary.hpp"
+#include "SceneIndex.hpp"
+#include "SceneDetector.hpp"
+#include "VideoSource.hpp"
 
 using namespace mdl::opencv;
+using mdl::LogoFinderStats;
 
 
 #define INFO(msg) ({if (verbose_) { std::cout << msg; }})
@@ -40,14 +47,12 @@ using namespace mdl::opencv;
 
 OpenCVLogoFinder::OpenCVLogoFinder(const std::string& file, LogoFinderCallback& callback, bool verbose)
   : LogoFinder(callback, verbose)
+  , file_(file)
   , n_last_failures_(0)
   , stop_requested_(false)
 {
-  cap_.open(file);
-  if (!cap_.isOpened()) {
-    throw mdl::VideoNotOpenedException();
-  }
-  total_frames_ = cap_.get(cv::CAP_PROP_FRAME_COUNT);
+  source_ = create_video_source(file);
+  total_frames_ = source_->get_number_of_frames();
 
   kernel_sharpen_ = cv::Mat(3, 3, CV_64F, cv::Scalar(1));
   kernel_sharpen_.at<double>(1, 1) = -7;
@@ -56,25 +61,51 @@ OpenCVLogoFinder::OpenCVLogoFinder(const std::string& file, LogoFinderCallback&
 
   kernel_close_ = cv::getStructuringElement(cv::MORPH_RECT, cv::Size(7, 1));
 
-  int width_ = cap_.get(cv::CAP_PROP_FRAME_WIDTH);
-  int height_ = cap_.get(cv::CAP_PROP_FRAME_HEIGHT);
+  int width_ = source_->get_frame_width();
+  int height_ = source_->get_frame_height();
   t_avg_f_.create(height_, width_, CV_64FC3);
+
+  pyramid_levels_ = 0;
+  while ((height_ >> (pyramid_levels_ + 1)) >= pyramid_min_height_) {
+    ++pyramid_levels_;
+  }
+  kernel_close_reduced_ = cv::getStructuringElement(cv::MORPH_RECT,
+                                                    cv::Size(std::max(3, 7 >> pyramid_levels_), 1));
 }
 
 
 OpenCVLogoFinder::find_result OpenCVLogoFinder::find_logos()
 {
+  stats_.reset();
+  load_templates();
+  load_scenes();
+
   try {
+    int last_frame = std::min(end_frame_, total_frames_);
     int interval_start = start_frame_;
-  while (interval_start < total_frames_) {
+  while (interval_start < last_frame) {
     int interval_end = interval_start + frame_interval_min_;
-    if (interval_end > total_frames_) {
-      interval_end = total_frames_;
+    if (interval_end > last_frame) {
+      interval_end = last_frame;
     }
 
     INFO("find_logos iteration for [" << interval_start
          << ", " << interval_end << ")" << std::endl);
-    cv::Rect box = find_logo_in_interval(interval_start, interval_end);
+    cv::Rect box = match_templates(interval_start, interval_end);
+    if (box.width == 0) {
+      box = find_logo_in_interval(interval_start, interval_end);
+      if (box.x != 0) {
+        // t_avg_ still has the average where the logo was found
+        if (t_avg_.channels() == 1) {
+          t_logo_ = cv::Mat(t_avg_, box).clone();
+        } else {
+          cv::cvtColor(cv::Mat(t_avg_, box), t_logo_, cv::COLOR_BGR2GRAY);
+        }
+        if (!template_file_.empty()) {
+          templates_.add(t_avg_, box);
+        }
+      }
+    }
     INFO("  logo found = " << RECT_STR(box) << std::endl);
 
     if (stop_requested_) {
@@ -82,7 +113,13 @@ OpenCVLogoFinder::find_result OpenCVLogoFinder::find_logos()
     }
 
     if (box.x != 0) {
-      int new_start = get_logo_transition_point(interval_end, box);
+      int new_start = tracking_
+        ? track_logo(interval_end, box)
+        : get_logo_transition_point(interval_end, box);
+      if (stop_requested_) {
+        // The logo may have been followed only part of the way
+        break;
+      }
 
       LogoFinderResult result{.start_frame = interval_start,
                               .end_frame = new_start - 1,
@@ -93,25 +130,112 @@ OpenCVLogoFinder::find_result OpenCVLogoFinder::find_logos()
       interval_start = new_start;
       n_last_failures_ = 0;
     } else {
-      callback_.failure(interval_start, interval_end - 1);
+      int failure_end = get_failure_interval_end(interval_start, interval_end);
+      callback_.failure(interval_start, failure_end - 1);
 
-      interval_start += frame_interval_min_;
+      interval_start = failure_end;
       ++n_last_failures_;
     }
   }
 
+  save_templates();
   return std::make_pair(true, "");
   } catch (const FrameNotAvailableException& e) {
+    save_templates();
     return std::make_pair(false, "Could not get frame " + std::to_string(e.get_frame()));
   }
 }
 
 
+/**
+ * Searches the known logos in a few frames spread over the
+ * interval, the last one being the last frame of the interval. The
+ * same logo must be found in the same place in all of them.
+ */
+cv::Rect OpenCVLogoFinder::match_templates(int interval_start, int interval_end)
+{
+  if (templates_.empty()) {
+    return cv::Rect();
+  }
+
+  int index = -1;
+  cv::Rect box;
+  int n_frames = std::min(template_frames_, interval_end - interval_start);
+  for (int i = 1; i <= n_frames; ++i) {
+    int frame = interval_start + (interval_end - 1 - interval_start) * i / n_frames;
+    go_to_frame(frame);
+    advance_frame();
+    get_frame();
+
+    LogoFinderStats::Timer timer(stats_, LogoFinderStats::Stage::MATCH);
+    cv::cvtColor(t_frame_, t_grey_, cv::COLOR_BGR2GRAY);
+    cv::Rect frame_box;
+    int frame_index = templates_.match(t_grey_, frame_box);
+    if (frame_index == -1
+        || (index != -1 && (frame_index != index
+                            || std::abs(frame_box.x - box.x) > 2
+                            || std::abs(frame_box.y - box.y) > 2))) {
+      INFO("  templates not matched in frame " << frame << std::endl);
+      return cv::Rect();
+    }
+    index = frame_index;
+    box = frame_box;
+  }
+
+  INFO("  template " << index << " matched = " << RECT_STR(box) << std::endl);
+  t_logo_ = templates_.image(index).clone();
+  templates_.count_match(index);
+  return box;
+}
+
+
+void OpenCVLogoFinder::load_templates()
+{
+  if (template_file_.empty()) {
+    return;
+  }
+
+  if (templates_.load(template_file_)) {
+    INFO("Loaded " << templates_.size() << " logo templates from " << template_file_ << std::endl);
+  }
+}
+
+
+void OpenCVLogoFinder::save_templates()
+{
+  if (template_file_.empty() || !templates_.modified()) {
+    return;
+  }
+
+  if (!templates_.save(template_file_)) {
+    INFO("Could not save logo templates to " << template_file_ << std::endl);
+  }
+}
+
+
+int OpenCVLogoFinder::steps() const
+{
+  return thorough_ ? thorough_steps_ : steps_;
+}
+
+
+int OpenCVLogoFinder::frame_step() const
+{
+  return thorough_ ? thorough_frame_step_ : frame_step_;
+}
+
+
+int OpenCVLogoFinder::gradient_threshold() const
+{
+  return thorough_ ? thorough_gradient_threshold_ : gradient_threshold_;
+}
+
+
 cv::Rect OpenCVLogoFinder::find_logo_in_interval(int interval_start, int interval_end)
 {
   int n_subintervals = 1;
   int level = 1;
-  while (level <= steps_) {
+  while (level <= steps()) {
     auto subintervals = IntervalCalculator::get_subintervals(interval_start, interval_end, n_subintervals);
 
     std::vector<cv::Rect> subinterval_boxes;
@@ -142,12 +266,99 @@ cv::Rect OpenCVLogoFinder::find_logo_in_interval(int interval_start, int interva
 cv::Rect OpenCVLogoFinder::find_boxes(int start_frame, int end_frame)
 {
   INFO("  find_boxes in [" << start_frame << ", " << end_frame << ")" << std::endl);
+  if (progressive_) {
+    return find_boxes_progressive(start_frame, end_frame);
+  }
+
   average_frame(start_frame, end_frame);
+  return find_boxes_in_average();
+}
+
+
+/**
+ * Averages the frames like average_frame(), but searches the box at
+ * checkpoints while doing it, and stops when the same box is found in
+ * two consecutive checkpoints. t_avg_ has the last average used.
+ */
+cv::Rect OpenCVLogoFinder::find_boxes_progressive(int start_frame, int end_frame)
+{
+  reset_average();
+
+  go_to_frame(start_frame);
+  int frames = 0;
+  int checkpoint = progressive_first_checkpoint_;
+  int last_checkpoint = 0;
+  cv::Rect box;
+  cv::Rect previous_box;
+  for (int f = start_frame; f < end_frame; ++f) {
+    advance_frame();
+    if (f % frame_step() != 0) {
+      continue;
+    }
 
-  cv::filter2D(t_avg_, t_sharpened_, -1, kernel_sharpen_);
+    add_frame_to_average();
+    ++frames;
+
+    if (stop_requested_) {
+      break;
+    }
+
+    if (frames == checkpoint) {
+      {
+        LogoFinderStats::Timer timer(stats_, LogoFinderStats::Stage::AVERAGE);
+        t_avg_f_.convertTo(t_avg_, CV_8U, 1. / frames);
+      }
+      box = find_boxes_in_average();
+      if (box.x != 0 && is_same_box(box, previous_box)) {
+        int skipped = IntervalCalculator::count_samples(f + 1, end_frame, frame_step());
+        INFO("    box stable after " << frames << " frames, " << skipped << " skipped" << std::endl);
+        stats_.count_skipped_frames(skipped);
+        return box;
+      }
+      previous_box = box;
+      last_checkpoint = checkpoint;
+      checkpoint *= 2;
+    }
+  }
+
+  if (frames == 0) {
+    return cv::Rect();
+  }
+  if (last_checkpoint != 0 && frames == last_checkpoint) {
+    // The last checkpoint was the last frame, nothing new to search
+    return box;
+  }
+
+  {
+    LogoFinderStats::Timer timer(stats_, LogoFinderStats::Stage::AVERAGE);
+    t_avg_f_.convertTo(t_avg_, CV_8U, 1. / frames);
+  }
+  return find_boxes_in_average();
+}
+
+
+bool OpenCVLogoFinder::is_same_box(const cv::Rect& box1, const cv::Rect& box2) const
+{
+  return std::abs(box1.x - box2.x) <= progressive_tolerance_
+    && std::abs(box1.y - box2.y) <= progressive_tolerance_
+    && std::abs(box1.width - box2.width) <= progressive_tolerance_
+    && std::abs(box1.height - box2.height) <= progressive_tolerance_;
+}
+
+
+cv::Rect OpenCVLogoFinder::find_boxes_in_average()
+{
+  if (pyramid_ && pyramid_levels_ > 0) {
+    return find_boxes_in_pyramid();
+  }
+
+  {
+    LogoFinderStats::Timer timer(stats_, LogoFinderStats::Stage::SHARPEN);
+    cv::filter2D(t_avg_, t_sharpened_, -1, kernel_sharpen_);
+  }
 
   std::vector<cv::Rect> boxes;
-  for (int channel = 0; channel <= 2; ++channel) {
+  for (int channel = 0; channel < t_sharpened_.channels(); ++channel) {
     boxes.push_back(find_box_in_channel(t_sharpened_, channel));
   }
 
@@ -157,19 +368,17 @@ cv::Rect OpenCVLogoFinder::find_boxes(int start_frame, int end_frame)
 
 void OpenCVLogoFinder::average_frame(int start_frame, int end_frame)
 {
-  t_avg_f_.setTo(cv::Scalar(0, 0, 0));
+  reset_average();
 
   go_to_frame(start_frame);
   int frames = 0;
   for (int f = start_frame; f < end_frame; ++f) {
     advance_frame();
-    if (f % frame_step_ != 0) {
+    if (f % frame_step() != 0) {
       continue;
     }
 
-    get_frame();
-    t_frame_.convertTo(t_frame_f_, CV_64FC3);
-    t_avg_f_ += t_frame_f_;
+    add_frame_to_average();
     ++frames;
 
     if (stop_requested_) {
@@ -177,50 +386,162 @@ void OpenCVLogoFinder::average_frame(int start_frame, int end_frame)
     }
   }
 
+  LogoFinderStats::Timer timer(stats_, LogoFinderStats::Stage::AVERAGE);
   t_avg_f_.convertTo(t_avg_, CV_8U, 1. / frames);
 }
 
 
+/**
+ * In luma mode, only the luma of the frames is averaged, and the
+ * boxes are searched in it alone instead of in each colour channel.
+ */
+void OpenCVLogoFinder::reset_average()
+{
+  t_avg_f_.create(t_avg_f_.rows, t_avg_f_.cols, luma_ ? CV_64F : CV_64FC3);
+  t_avg_f_.setTo(cv::Scalar::all(0));
+}
+
+
+void OpenCVLogoFinder::add_frame_to_average()
+{
+  if (luma_) {
+    get_luma_frame();
+  } else {
+    get_frame();
+  }
+
+  LogoFinderStats::Timer timer(stats_, LogoFinderStats::Stage::AVERAGE);
+  if (luma_) {
+    t_luma_.convertTo(t_frame_f_, CV_64F);
+  } else {
+    t_frame_.convertTo(t_frame_f_, CV_64FC3);
+  }
+  t_avg_f_ += t_frame_f_;
+}
+
+
 void OpenCVLogoFinder::go_to_frame(int frame_number)
 {
-  cap_.set(cv::CAP_PROP_POS_FRAMES, frame_number);
+  LogoFinderStats::Timer timer(stats_, LogoFinderStats::Stage::SEEK);
+  stats_.count_seek();
+  source_->seek(frame_number);
   current_frame_ = frame_number;
 }
 
 
 void OpenCVLogoFinder::advance_frame()
 {
-  bool success = cap_.grab();
+  LogoFinderStats::Timer timer(stats_, LogoFinderStats::Stage::DECODE);
+  bool success = source_->grab();
   if (!success) {
     throw mdl::FrameNotAvailableException(current_frame_);
   }
+  stats_.count_decoded_frame();
   ++current_frame_;
 }
 
 
 void OpenCVLogoFinder::get_frame()
 {
-  bool success = cap_.retrieve(t_frame_);
+  LogoFinderStats::Timer timer(stats_, LogoFinderStats::Stage::RETRIEVE);
+  bool success = source_->retrieve(t_frame_);
   if (!success) {
     throw mdl::FrameNotAvailableException(current_frame_);
   }
+  stats_.count_used_frame();
 }
 
 
-cv::Rect OpenCVLogoFinder::find_box_in_channel(const cv::Mat& average_frame, int channel)
+/**
+ * Gets only the luma of the frame in t_luma_, which for YUV videos
+ * read with libav needs no conversion.
+ */
+void OpenCVLogoFinder::get_luma_frame()
 {
-  cv::extractChannel(average_frame, t_grey_, channel);
-  cv::morphologyEx(t_grey_, t_gradient_, cv::MORPH_GRADIENT, kernel_gradient_);
-  cv::threshold(t_gradient_, t_thresh_, 190, 255, cv::THRESH_BINARY);
-  cv::morphologyEx(t_thresh_, t_closed_, cv::MORPH_CLOSE, kernel_close_, cv::Point(-1, -1), close_steps_);
+  LogoFinderStats::Timer timer(stats_, LogoFinderStats::Stage::RETRIEVE);
+  bool success = source_->retrieve_luma(t_luma_);
+  if (!success) {
+    throw mdl::FrameNotAvailableException(current_frame_);
+  }
+  stats_.count_used_frame();
+}
+
 
+/**
+ * Searches for the box in the average reduced pyramid_levels_ times,
+ * with the size limits reduced by the same factor, and then again at
+ * full size, only around the box found. If it isn't found again, the
+ * box found in the reduced frame is scaled up.
+ */
+cv::Rect OpenCVLogoFinder::find_boxes_in_pyramid()
+{
+  int factor = 1 << pyramid_levels_;
+  {
+    LogoFinderStats::Timer timer(stats_, LogoFinderStats::Stage::SHARPEN);
+    cv::resize(t_avg_, t_reduced_, cv::Size(t_avg_.cols / factor, t_avg_.rows / factor),
+               0, 0, cv::INTER_AREA);
+    cv::filter2D(t_reduced_, t_sharpened_, -1, kernel_sharpen_);
+  }
+
+  std::vector<cv::Rect> boxes;
+  for (int channel = 0; channel < t_sharpened_.channels(); ++channel) {
+    boxes.push_back(find_box_in_channel(t_sharpened_, channel, pyramid_levels_));
+  }
+  cv::Rect reduced_box = select_box(boxes);
+  if (reduced_box.x == 0) {
+    return reduced_box;
+  }
+
+  cv::Rect frame_rect(0, 0, t_avg_.cols, t_avg_.rows);
+  cv::Rect candidate(reduced_box.x * factor, reduced_box.y * factor,
+                     reduced_box.width * factor, reduced_box.height * factor);
+  int margin = pyramid_margin_ * factor;
+  cv::Rect roi(candidate.x - margin, candidate.y - margin,
+               candidate.width + 2*margin, candidate.height + 2*margin);
+  roi &= frame_rect;
+
+  {
+    LogoFinderStats::Timer timer(stats_, LogoFinderStats::Stage::SHARPEN);
+    cv::filter2D(cv::Mat(t_avg_, roi), t_sharpened_, -1, kernel_sharpen_);
+  }
+
+  boxes.clear();
+  for (int channel = 0; channel < t_sharpened_.channels(); ++channel) {
+    boxes.push_back(find_box_in_channel(t_sharpened_, channel));
+  }
+  cv::Rect box = select_box(boxes);
+  if (box.x == 0) {
+    INFO("    refined box not found, using " << RECT_STR(candidate) << std::endl);
+    return candidate & frame_rect;
+  }
+
+  return cv::Rect(box.x + roi.x, box.y + roi.y, box.width, box.height);
+}
+
+
+/**
+ * level is the number of times the frame was halved. The size
+ * limits are reduced by the same factor.
+ */
+cv::Rect OpenCVLogoFinder::find_box_in_channel(const cv::Mat& average_frame, int channel, int level)
+{
+  const cv::Mat& kernel_close = level == 0 ? kernel_close_ : kernel_close_reduced_;
+  {
+    LogoFinderStats::Timer timer(stats_, LogoFinderStats::Stage::MORPHOLOGY);
+    cv::extractChannel(average_frame, t_grey_, channel);
+    cv::morphologyEx(t_grey_, t_gradient_, cv::MORPH_GRADIENT, kernel_gradient_);
+    cv::threshold(t_gradient_, t_thresh_, gradient_threshold(), 255, cv::THRESH_BINARY);
+    cv::morphologyEx(t_thresh_, t_closed_, cv::MORPH_CLOSE, kernel_close, cv::Point(-1, -1), close_steps_);
+  }
+
+  LogoFinderStats::Timer timer(stats_, LogoFinderStats::Stage::CONTOURS);
   std::vector<std::vector<cv::Point>> contours;
   cv::findContours(t_closed_, contours, cv::RETR_CCOMP, cv::CHAIN_APPROX_NONE);
 
   for (auto& contour: contours) {
     cv::Rect rect = cv::boundingRect(contour);
-    if ((rect.width >= min_logo_width_ && rect.width <= max_logo_width_)
-        && (rect.height >= min_logo_height_ && rect.height <= max_logo_height_)) {
+    if ((rect.width >= (min_logo_width_ >> level) && rect.width <= (max_logo_width_ >> level))
+        && (rect.height >= (min_logo_height_ >> level) && rect.height <= (max_logo_height_ >> level))) {
       INFO("    find_box_in_channel " << channel << " = " << RECT_STR(rect) << std::endl);
       return rect;
     }
@@ -261,6 +582,16 @@ int OpenCVLogoFinder::get_logo_transition_point(int current_frame, const cv::Rec
     return current_frame;
   }
 
+  if (scenes_.total_frames() > 0) {
+    return get_logo_transition_point_at_cuts(current_frame, extra_frames_to_check, box);
+  }
+
+  // The progressive search can stop averaging before the end of the
+  // interval, so the comparison must start from its last frame
+  if (current_frame_ != current_frame) {
+    go_to_frame(current_frame - 1);
+    advance_frame();
+  }
   get_frame();
   for (int i = 0; i < extra_frames_to_check; ++i) {
     cv::Mat logo = cv::Mat(t_frame_, box).clone();
@@ -268,8 +599,12 @@ int OpenCVLogoFinder::get_logo_transition_point(int current_frame, const cv::Rec
     get_frame();
     cv::Mat logo_next = cv::Mat(t_frame_, box);
 
-    double norm = cv::norm(logo, logo_next, cv::NORM_L2);
-    double difference = norm / (logo.rows * logo.cols);
+    double difference;
+    {
+      LogoFinderStats::Timer timer(stats_, LogoFinderStats::Stage::COMPARE);
+      double norm = cv::norm(logo, logo_next, cv::NORM_L2);
+      difference = norm / (logo.rows * logo.cols);
+    }
 
     INFO("  extra frame " << current_frame << " difference = " << difference << std::endl);
 
@@ -284,6 +619,114 @@ int OpenCVLogoFinder::get_logo_transition_point(int current_frame, const cv::Rec
 }
 
 
+/**
+ * Logos usually change at shot boundaries, so only the cuts are
+ * checked instead of every frame.
+ */
+int OpenCVLogoFinder::get_logo_transition_point_at_cuts(int current_frame, int extra_frames,
+                                                        const cv::Rect& box)
+{
+  int last_frame = std::min(current_frame + extra_frames, total_frames_);
+  for (int cut: scenes_.cuts_between(current_frame, last_frame)) {
+    if (!is_logo_present(cut, box)) {
+      INFO("  logo changes at cut " << cut << std::endl);
+      return cut;
+    }
+  }
+
+  return last_frame;
+}
+
+
+/**
+ * When no logo is found, the logo probably changed inside the
+ * interval. The next one starts at the last cut, so that it doesn't
+ * include the shot before it.
+ */
+int OpenCVLogoFinder::get_failure_interval_end(int interval_start, int interval_end)
+{
+  if (scenes_.total_frames() == 0) {
+    return interval_end;
+  }
+
+  // Too close to the start would make the next interval overlap most
+  // of this one
+  int cut = scenes_.last_cut_between(interval_start + frame_interval_min_ / 4 + 1, interval_end);
+  return cut == -1 ? interval_end : cut;
+}
+
+
+void OpenCVLogoFinder::load_scenes()
+{
+  scenes_ = SceneIndex();
+  if (!scene_detection_) {
+    return;
+  }
+
+  std::string index_file = file_ + ".scenes";
+  std::ifstream in(index_file);
+  if (in.is_open() && scenes_.load(in) && scenes_.total_frames() == total_frames_) {
+    INFO("Loaded " << scenes_.cuts().size() << " scene changes from " << index_file << std::endl);
+    return;
+  }
+
+  INFO("Detecting scene changes" << std::endl);
+  try {
+    LogoFinderStats::Timer timer(stats_, LogoFinderStats::Stage::SCENES);
+    scenes_ = SceneDetector(file_).detect(stop_requested_);
+  } catch (const VideoNotOpenedException&) {
+    scenes_ = SceneIndex();
+    return;
+  }
+  INFO("  " << scenes_.cuts().size() << " scene changes found" << std::endl);
+
+  if (stop_requested_) {
+    return;
+  }
+
+  std::ofstream out(index_file);
+  if (out.is_open()) {
+    scenes_.save(out);
+  }
+}
+
+
+/**
+ * Follows the logo after current_frame, checking frames further and
+ * further ahead while it is still there, up to the minimum interval
+ * apart, so that it can't disappear and come back between two
+ * checks. Returns the first frame without the logo.
+ */
+int OpenCVLogoFinder::track_logo(int current_frame, const cv::Rect& box)
+{
+  int last_frame = std::min(end_frame_, total_frames_);
+  int transition = IntervalCalculator::find_transition(
+    current_frame - 1, last_frame, tracking_step_, frame_interval_min_,
+    [this, &box](int frame) {
+      return !stop_requested_ && is_logo_present(frame, box);
+    });
+
+  INFO("  logo followed until frame " << transition << std::endl);
+  return transition;
+}
+
+
+bool OpenCVLogoFinder::is_logo_present(int frame, const cv::Rect& box)
+{
+  go_to_frame(frame);
+  advance_frame();
+  get_frame();
+
+  LogoFinderStats::Timer timer(stats_, LogoFinderStats::Stage::MATCH);
+  cv::cvtColor(cv::Mat(t_frame_, box), t_grey_, cv::COLOR_BGR2GRAY);
+  cv::matchTemplate(t_grey_, t_logo_, t_match_, cv::TM_CCOEFF_NORMED);
+  double score = t_match_.at<float>(0, 0);
+  INFO("    frame " << frame << " logo correlation = " << score << std::endl);
+
+  return score >= tracking_threshold_;
+}
+
+
 void OpenCVLogoFinder::stop()
 {
   stop_requested_ = true;
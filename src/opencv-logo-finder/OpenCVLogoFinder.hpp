@@ -21,11 +21,16 @@
 
 #include <string>
 #include <vector>
+#include <memory>
 
-#include <opencv2/videoio.hpp>
+#include <opencv2/core.hpp>
 
 #include "gui/common/LogoFinder.hpp"
 
+#include "LogoTemplateLibrary.hpp"
+#include "SceneIndex.hpp"
+#include "VideoSource.hpp"
+
 
 namespace mdl { namespace opencv {
   class OpenCVLogoFinder: public LogoFinder
@@ -37,13 +42,21 @@ namespace mdl { namespace opencv {
 
     void stop() override;
 
+    friend class OpenCVLogoFinderBenchmark;
+    friend class OpenCVLogoFinderTest;
+
   private:
-    cv::VideoCapture cap_;
+    std::string file_;
+    std::unique_ptr<VideoSource> source_;
     int total_frames_;
 
     cv::Mat kernel_sharpen_;
     cv::Mat kernel_gradient_;
     cv::Mat kernel_close_;
+    cv::Mat kernel_close_reduced_;
+
+    /** Number of times the frame is halved in pyramid mode */
+    int pyramid_levels_;
 
     int n_last_failures_;
 
@@ -51,6 +64,10 @@ namespace mdl { namespace opencv {
 
     int current_frame_;
 
+    LogoTemplateLibrary templates_;
+    /** Empty, with no frames, when scene detection is not used */
+    SceneIndex scenes_;
+
     /**
      * Number of steps to do while searching for the logo in an
      * interval. The first step considers the whole interval, the
@@ -65,6 +82,39 @@ namespace mdl { namespace opencv {
      * it faster, but possibly less accurate.
      */
     int frame_step_ = 10;
+    /**
+     * Number of frames averaged before the box is first searched in
+     * progressive mode. Following searches are done every time the
+     * number of frames doubles.
+     */
+    int progressive_first_checkpoint_ = 8;
+    /**
+     * Maximal difference, in pixels, in the position and size of the
+     * boxes found in two checkpoints for the box to be considered
+     * stable.
+     */
+    int progressive_tolerance_ = 2;
+    /**
+     * In pyramid mode, the frame is halved while its height stays at
+     * least this. Smaller videos are searched at full size.
+     */
+    int pyramid_min_height_ = 720;
+    /**
+     * Margin, in pixels of the reduced frame, added around the box
+     * found in it before searching again at full size.
+     */
+    int pyramid_margin_ = 4;
+    /**
+     * Minimal morphological gradient of the logo borders. Lower finds
+     * logos with less contrast, but also more false borders.
+     */
+    int gradient_threshold_ = 190;
+    /**
+     * Used instead of the ones above in thorough mode.
+     */
+    int thorough_steps_ = 3;
+    int thorough_frame_step_ = 4;
+    int thorough_gradient_threshold_ = 150;
     /**
      * Number of times to apply CLOSE morphology.
      */
@@ -76,34 +126,73 @@ namespace mdl { namespace opencv {
      * also generate more incorrect results.
      */
     double similarity_threshold_ = 0.7;
+    /**
+     * Number of frames of an interval where the known logos are
+     * searched. A logo is only accepted if it is found in all of
+     * them.
+     */
+    int template_frames_ = 3;
+    /**
+     * First step, in frames, when following a logo. It doubles after
+     * each frame where the logo is still present.
+     */
+    int tracking_step_ = 25;
+    /**
+     * Minimal normalized correlation with the logo for it to be
+     * considered still present while following it.
+     */
+    double tracking_threshold_ = 0.7;
+
 
+    int steps() const;
+    int frame_step() const;
+    int gradient_threshold() const;
 
     cv::Rect find_logo_in_interval(int interval_start, int interval_end);
+    cv::Rect match_templates(int interval_start, int interval_end);
+    void load_templates();
+    void save_templates();
 
     cv::Rect find_boxes(int start_frame, int end_frame);
+    cv::Rect find_boxes_progressive(int start_frame, int end_frame);
+    cv::Rect find_boxes_in_average();
+    cv::Rect find_boxes_in_pyramid();
+    bool is_same_box(const cv::Rect& box1, const cv::Rect& box2) const;
 
     void average_frame(int start_frame, int end_frame);
+    void reset_average();
+    void add_frame_to_average();
     void go_to_frame(int frame_number);
     void advance_frame();
     void get_frame();
+    void get_luma_frame();
 
-    cv::Rect find_box_in_channel(const cv::Mat& average_frame, int channel);
+    cv::Rect find_box_in_channel(const cv::Mat& average_frame, int channel, int level = 0);
     cv::Rect select_box(const std::vector<cv::Rect>& boxes);
 
     int get_logo_transition_point(int current_frame, const cv::Rect& box);
+    int get_logo_transition_point_at_cuts(int current_frame, int extra_frames, const cv::Rect& box);
+    int get_failure_interval_end(int interval_start, int interval_end);
+    void load_scenes();
+    int track_logo(int current_frame, const cv::Rect& box);
+    bool is_logo_present(int frame, const cv::Rect& box);
 
     // Temporary variables
     // They were made class members so that they are allocated only once
     cv::Mat t_avg_;   // Last average frame
     cv::Mat t_frame_; // Last frame read
+    cv::Mat t_logo_;  // Greyscale image of the last logo found
     // The ones below are used only in one function each
     cv::Mat t_avg_f_;
     cv::Mat t_frame_f_;
     cv::Mat t_sharpened_;
+    cv::Mat t_reduced_;
+    cv::Mat t_luma_;
     cv::Mat t_grey_;
     cv::Mat t_gradient_;
     cv::Mat t_thresh_;
     cv::Mat t_closed_;
+    cv::Mat t_match_;
   };
 } }
 
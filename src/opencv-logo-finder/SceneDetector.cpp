@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <vector>
+
+#include <opencv2/imgproc.hpp>
+
+#include "SceneDetector.hpp"
+#include "SceneIndex.hpp"
+#include "VideoSource.hpp"
+
+using namespace mdl::opencv;
+
+
+SceneDetector::SceneDetector(const std::string& file)
+  : source_(open_video_source(file))
+{
+}
+
+
+SceneIndex SceneDetector::detect(const bool& stop)
+{
+  int total_frames = source_->get_number_of_frames();
+  cv::Size size(width_, height_);
+
+  std::vector<double> differences;
+  differences.reserve(total_frames);
+
+  cv::Mat luma, grey, previous;
+  while (!stop && source_->grab() && source_->retrieve_luma(luma)) {
+    cv::resize(luma, grey, size, 0, 0, cv::INTER_AREA);
+
+    if (previous.empty()) {
+      differences.push_back(0);
+    } else {
+      differences.push_back(cv::norm(grey, previous, cv::NORM_L1) / (width_ * height_));
+    }
+    cv::swap(grey, previous);
+  }
+
+  return SceneIndex(total_frames, SceneIndex::find_cuts(differences, min_difference_, ratio_, window_));
+}
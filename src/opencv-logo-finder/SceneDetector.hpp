@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MDL_OPENCV_SCENE_DETECTOR_H
+#define MDL_OPENCV_SCENE_DETECTOR_H
+
+#include <string>
+#include <memory>
+
+#include "SceneIndex.hpp"
+#include "VideoSource.hpp"
+
+
+namespace mdl { namespace opencv {
+  /**
+   * Builds a SceneIndex for a video, comparing each frame with the
+   * previous one. Frames are reduced to a small greyscale image
+   * before being compared, so the time is mostly spent decoding.
+   * Every frame is read once, so it uses a decoder of its own
+   * instead of the source of the logo finder.
+   */
+  class SceneDetector
+  {
+  public:
+    /** Throws VideoNotOpenedException */
+    explicit SceneDetector(const std::string& file);
+
+    /** Stops early, returning the cuts found so far, if stop becomes true */
+    SceneIndex detect(const bool& stop);
+
+    /** Size of the images compared */
+    int width_ = 64;
+    int height_ = 36;
+    /** Minimal mean absolute difference of a cut, in grey levels */
+    double min_difference_ = 20;
+    /** How many times larger than the recent differences a cut must be */
+    double ratio_ = 3;
+    /** Number of frames used to calculate the recent differences */
+    int window_ = 25;
+
+  private:
+    std::unique_ptr<VideoSource> source_;
+  };
+} }
+
+
+#endif // MDL_OPENCV_SCENE_DETECTOR_H
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <istream>
+#include <ostream>
+
+#include "SceneIndex.hpp"
+
+using namespace mdl::opencv;
+
+
+const char* SceneIndex::HEADER_ = "multi-delogo scenes 1";
+
+
+SceneIndex::SceneIndex()
+  : total_frames_(0)
+{
+}
+
+
+SceneIndex::SceneIndex(int total_frames, const std::vector<int>& cuts)
+  : total_frames_(total_frames)
+  , cuts_(cuts)
+{
+}
+
+
+std::vector<int> SceneIndex::find_cuts(const std::vector<double>& differences,
+                                       double min_difference, double ratio, int window)
+{
+  std::vector<int> cuts;
+
+  double window_sum = 0;
+  int window_frames = 0;
+  for (std::size_t frame = 1; frame < differences.size(); ++frame) {
+    double difference = differences[frame];
+    double average = window_frames > 0 ? window_sum / window_frames : 0;
+
+    if (difference >= min_difference && difference >= ratio * average) {
+      cuts.push_back(frame);
+    }
+
+    window_sum += difference;
+    if (window_frames == window) {
+      window_sum -= differences[frame - window];
+    } else {
+      ++window_frames;
+    }
+  }
+
+  return cuts;
+}
+
+
+bool SceneIndex::empty() const
+{
+  return cuts_.empty();
+}
+
+
+int SceneIndex::total_frames() const
+{
+  return total_frames_;
+}
+
+
+const std::vector<int>& SceneIndex::cuts() const
+{
+  return cuts_;
+}
+
+
+std::vector<int> SceneIndex::cuts_between(int first, int last) const
+{
+  auto begin = std::lower_bound(cuts_.begin(), cuts_.end(), first);
+  auto end = std::lower_bound(begin, cuts_.end(), last);
+  return std::vector<int>(begin, end);
+}
+
+
+int SceneIndex::last_cut_between(int first, int last) const
+{
+  auto i = std::lower_bound(cuts_.begin(), cuts_.end(), last);
+  if (i == cuts_.begin() || *(i - 1) < first) {
+    return -1;
+  }
+  return *(i - 1);
+}
+
+
+bool SceneIndex::load(std::istream& in)
+{
+  total_frames_ = 0;
+  cuts_.clear();
+
+  std::string header;
+  if (!std::getline(in, header) || header != HEADER_) {
+    return false;
+  }
+
+  int total_frames;
+  if (!(in >> total_frames)) {
+    return false;
+  }
+
+  std::vector<int> cuts;
+  int cut;
+  while (in >> cut) {
+    if (cut <= 0 || cut >= total_frames || (!cuts.empty() && cut <= cuts.back())) {
+      return false;
+    }
+    cuts.push_back(cut);
+  }
+  if (!in.eof()) {
+    return false;
+  }
+
+  total_frames_ = total_frames;
+  cuts_ = cuts;
+  return true;
+}
+
+
+void SceneIndex::save(std::ostream& out) const
+{
+  out << HEADER_ << "\n"
+      << total_frames_ << "\n";
+  for (int cut: cuts_) {
+    out << cut << "\n";
+  }
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MDL_OPENCV_SCENE_INDEX_H
+#define MDL_OPENCV_SCENE_INDEX_H
+
+#include <vector>
+#include <istream>
+#include <ostream>
+
+
+namespace mdl { namespace opencv {
+  /**
+   * Frames where a new shot starts in a video. Logos usually change
+   * at shot boundaries, so the logo finder uses them to check only
+   * these frames when looking for where a logo ends, and to start
+   * intervals at them.
+   */
+  class SceneIndex
+  {
+  public:
+    SceneIndex();
+    SceneIndex(int total_frames, const std::vector<int>& cuts);
+
+    /**
+     * Finds the cuts given the difference between each frame and the
+     * previous one. A frame is a cut if its difference is at least
+     * min_difference and at least ratio times the average difference
+     * of the previous window frames, so that scenes with a lot of
+     * motion don't generate cuts in every frame.
+     */
+    static std::vector<int> find_cuts(const std::vector<double>& differences,
+                                      double min_difference, double ratio, int window);
+
+    bool empty() const;
+    int total_frames() const;
+    const std::vector<int>& cuts() const;
+
+    /** Cuts c such that first <= c < last */
+    std::vector<int> cuts_between(int first, int last) const;
+    /** The last cut c such that first <= c < last, or -1 */
+    int last_cut_between(int first, int last) const;
+
+    /** Returns false, leaving the index empty, if the data is invalid */
+    bool load(std::istream& in);
+    void save(std::ostream& out) const;
+
+  private:
+    int total_frames_;
+    std::vector<int> cuts_;
+
+    static const char* HEADER_;
+  };
+} }
+
+
+#endif // MDL_OPENCV_SCENE_INDEX_H
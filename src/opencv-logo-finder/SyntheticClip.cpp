@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <vector>
+#include <istream>
+#include <sstream>
+#include <algorithm>
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include "SyntheticClip.hpp"
+#include "Y4MWriter.hpp"
+
+using namespace mdl::opencv;
+
+
+SyntheticClip::SyntheticClip(int width, int height, double fps)
+  : width_(width)
+  , height_(height)
+  , fps_(fps)
+  , scene_length_(40)
+  , seed_(0x6d646c)
+{
+}
+
+
+void SyntheticClip::set_scene_length(int frames)
+{
+  scene_length_ = std::max(frames, 1);
+}
+
+
+void SyntheticClip::set_seed(unsigned seed)
+{
+  seed_ = seed;
+}
+
+
+void SyntheticClip::write(const std::string& file, const std::vector<ScriptedLogo>& script) const
+{
+  int total_frames = 0;
+  for (const auto& logo: script) {
+    total_frames = std::max(total_frames, logo.end_frame);
+  }
+
+  Y4MWriter writer(file, width_, height_, fps_);
+
+  cv::RNG rng(seed_);
+  cv::Mat scene_small(9, 16, CV_8UC3);
+  cv::Mat scene;
+  cv::Mat noise(height_, width_, CV_8UC3);
+  cv::Mat frame;
+
+  for (int f = 0; f < total_frames; ++f) {
+    if (f % scene_length_ == 0) {
+      rng.fill(scene_small, cv::RNG::UNIFORM, cv::Scalar::all(30), cv::Scalar::all(200));
+      cv::resize(scene_small, scene, cv::Size(width_, height_), 0, 0, cv::INTER_CUBIC);
+    }
+
+    rng.fill(noise, cv::RNG::UNIFORM, cv::Scalar::all(0), cv::Scalar::all(24));
+    cv::add(scene, noise, frame);
+
+    for (const auto& logo: script) {
+      if (f >= logo.start_frame && f < logo.end_frame && logo.logo.area() > 0) {
+        cv::rectangle(frame, logo.logo, cv::Scalar(250, 250, 250), cv::FILLED);
+      }
+    }
+
+    writer.write(frame);
+  }
+}
+
+
+bool SyntheticClip::load_script(std::istream& in, std::vector<ScriptedLogo>& script)
+{
+  std::string line;
+  while (std::getline(in, line)) {
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+
+    std::istringstream fields(line);
+    ScriptedLogo logo;
+    fields >> logo.start_frame >> logo.end_frame
+           >> logo.logo.x >> logo.logo.y >> logo.logo.width >> logo.logo.height;
+    if (!fields || logo.start_frame < 0 || logo.end_frame <= logo.start_frame) {
+      return false;
+    }
+    script.push_back(logo);
+  }
+
+  return true;
+}
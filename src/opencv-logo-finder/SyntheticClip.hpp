@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MDL_OPENCV_SYNTHETIC_CLIP_H
+#define MDL_OPENCV_SYNTHETIC_CLIP_H
+
+#include <string>
+#include <vector>
+#include <istream>
+
+#include <opencv2/core.hpp>
+
+
+namespace mdl { namespace opencv {
+  /** A logo visible in the frames [start_frame, end_frame) */
+  struct ScriptedLogo
+  {
+    int start_frame;
+    int end_frame;
+    cv::Rect logo;
+  };
+
+
+  /**
+   * Generates videos with logos at known places, so that the logo
+   * finder can be tested and measured without recorded videos.
+   */
+  class SyntheticClip
+  {
+  public:
+    SyntheticClip(int width, int height, double fps);
+
+    /** How often the background changes, like a cut */
+    void set_scene_length(int frames);
+    void set_seed(unsigned seed);
+
+    /**
+     * Writes a Y4M video whose background changes every scene length
+     * frames and has some noise in every frame, with white logos
+     * drawn according to the script. It ends at the end of the last
+     * logo. The same video is generated every time for the same
+     * seed. Throws VideoNotOpenedException
+     */
+    void write(const std::string& file, const std::vector<ScriptedLogo>& script) const;
+
+    /**
+     * Reads a script with a logo per line, as
+     * "start_frame end_frame x y width height". Lines starting with #
+     * are ignored. Returns false if a line is invalid.
+     */
+    static bool load_script(std::istream& in, std::vector<ScriptedLogo>& script);
+
+  private:
+    int width_;
+    int height_;
+    double fps_;
+    int scene_length_;
+    unsigned seed_;
+  };
+} }
+
+
+#endif // MDL_OPENCV_SYNTHETIC_CLIP_H
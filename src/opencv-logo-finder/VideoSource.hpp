@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MDL_OPENCV_VIDEO_SOURCE_H
+#define MDL_OPENCV_VIDEO_SOURCE_H
+
+#include <string>
+#include <memory>
+
+#include <opencv2/core.hpp>
+
+
+namespace mdl { namespace opencv {
+  /**
+   * Where the logo finder reads frames from. The decoder is chosen
+   * when configuring: cv::VideoCapture, or libav directly when built
+   * --with-libav.
+   */
+  class VideoSource
+  {
+  public:
+    virtual ~VideoSource() { }
+
+    /** Makes frame_number the next frame grabbed */
+    virtual void seek(int frame_number) = 0;
+    /** Decodes the next frame, without converting it */
+    virtual bool grab() = 0;
+    /** Returns the last frame grabbed as BGR */
+    virtual bool retrieve(cv::Mat& frame) = 0;
+    /**
+     * Returns the luma of the last frame grabbed. It may point to the
+     * decoder memory, and is only valid until the next grab().
+     */
+    virtual bool retrieve_luma(cv::Mat& luma) = 0;
+
+    virtual int get_frame_width() = 0;
+    virtual int get_frame_height() = 0;
+    virtual int get_number_of_frames() = 0;
+    virtual double get_fps() = 0;
+  };
+
+
+  /**
+   * The source used by the logo finder. It is chosen when linking:
+   * programs that only search for logos link
+   * libdirect-video-source.a, which returns open_video_source(),
+   * and the GUI links the frame service, which shares the frames it
+   * decodes with the frame provider.
+   *
+   * Throws VideoNotOpenedException
+   */
+  std::unique_ptr<VideoSource> create_video_source(const std::string& file);
+
+  /** A new decoder for file. Throws VideoNotOpenedException */
+  std::unique_ptr<VideoSource> open_video_source(const std::string& file);
+} }
+
+
+#endif // MDL_OPENCV_VIDEO_SOURCE_H
@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstddef>
+#include <cstring>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "gui/common/Exceptions.hpp"
+
+#include "Y4MIndex.hpp"
+
+using namespace mdl::opencv;
+
+
+const char Y4MIndex::MAGIC_[] = "YUV4MPEG2 ";
+
+
+Y4MIndex::Y4MIndex(const char* data, std::size_t size)
+  : width_(0)
+  , height_(0)
+  , fps_(25)
+  , chroma_(Chroma::C420)
+{
+  if (!is_y4m(data, size)) {
+    throw VideoNotOpenedException();
+  }
+
+  const char* end = data + size;
+  const char* header_end = static_cast<const char*>(std::memchr(data, '\n', size));
+  if (!header_end) {
+    throw VideoNotOpenedException();
+  }
+
+  // Parameters are separated by spaces, each starting with its tag
+  const char* p = data + sizeof(MAGIC_) - 1;
+  while (p < header_end) {
+    const char* param_end = p;
+    while (param_end < header_end && *param_end != ' ') {
+      ++param_end;
+    }
+    if (param_end > p) {
+      parse_parameter(p, param_end - p);
+    }
+    p = param_end + 1;
+  }
+
+  if (width_ <= 0 || height_ <= 0 || fps_ <= 0) {
+    throw VideoNotOpenedException();
+  }
+
+  std::size_t luma_size = static_cast<std::size_t>(width_) * height_;
+  std::size_t chroma_size;
+  switch (chroma_) {
+  case Chroma::C420:
+    chroma_size = static_cast<std::size_t>((width_ + 1) / 2) * ((height_ + 1) / 2);
+    break;
+  case Chroma::C422:
+    chroma_size = static_cast<std::size_t>((width_ + 1) / 2) * height_;
+    break;
+  case Chroma::C444:
+    chroma_size = luma_size;
+    break;
+  default:
+    chroma_size = 0;
+    break;
+  }
+  frame_size_ = luma_size + 2 * chroma_size;
+
+  // Each frame has a header of its own, which may have parameters,
+  // so frames are not always at the same distance
+  p = header_end + 1;
+  while (p < end) {
+    if (end - p < 5 || std::memcmp(p, "FRAME", 5) != 0) {
+      break;
+    }
+    const char* frame_header_end = static_cast<const char*>(std::memchr(p, '\n', end - p));
+    if (!frame_header_end) {
+      break;
+    }
+    std::size_t offset = frame_header_end + 1 - data;
+    if (size - offset < frame_size_) {
+      // A truncated frame at the end is ignored
+      break;
+    }
+    frame_offsets_.push_back(offset);
+    p = data + offset + frame_size_;
+  }
+}
+
+
+bool Y4MIndex::is_y4m(const char* data, std::size_t size)
+{
+  return size >= sizeof(MAGIC_) - 1 && std::memcmp(data, MAGIC_, sizeof(MAGIC_) - 1) == 0;
+}
+
+
+void Y4MIndex::parse_parameter(const char* param, std::size_t length)
+{
+  std::string value(param + 1, length - 1);
+
+  switch (param[0]) {
+  case 'W':
+    width_ = std::atoi(value.c_str());
+    break;
+
+  case 'H':
+    height_ = std::atoi(value.c_str());
+    break;
+
+  case 'F': {
+    std::size_t colon = value.find(':');
+    if (colon == std::string::npos) {
+      throw VideoNotOpenedException();
+    }
+    double num = std::atof(value.substr(0, colon).c_str());
+    double den = std::atof(value.substr(colon + 1).c_str());
+    if (den <= 0) {
+      throw VideoNotOpenedException();
+    }
+    fps_ = num / den;
+    break;
+  }
+
+  case 'C':
+    if (value == "420" || value == "420jpeg" || value == "420paldv" || value == "420mpeg2") {
+      chroma_ = Chroma::C420;
+    } else if (value == "422") {
+      chroma_ = Chroma::C422;
+    } else if (value == "444") {
+      chroma_ = Chroma::C444;
+    } else if (value == "mono") {
+      chroma_ = Chroma::MONO;
+    } else {
+      // More than 8 bits per sample, or alpha
+      throw VideoNotOpenedException();
+    }
+    break;
+
+  default:
+    // Interlacing, aspect ratio and comments don't matter here
+    break;
+  }
+}
+
+
+int Y4MIndex::width() const
+{
+  return width_;
+}
+
+
+int Y4MIndex::height() const
+{
+  return height_;
+}
+
+
+double Y4MIndex::fps() const
+{
+  return fps_;
+}
+
+
+Y4MIndex::Chroma Y4MIndex::chroma() const
+{
+  return chroma_;
+}
+
+
+int Y4MIndex::number_of_frames() const
+{
+  return frame_offsets_.size();
+}
+
+
+std::size_t Y4MIndex::frame_size() const
+{
+  return frame_size_;
+}
+
+
+std::size_t Y4MIndex::frame_offset(int frame_number) const
+{
+  return frame_offsets_[frame_number];
+}
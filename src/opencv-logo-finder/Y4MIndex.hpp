@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MDL_OPENCV_Y4M_INDEX_H
+#define MDL_OPENCV_Y4M_INDEX_H
+
+#include <cstddef>
+#include <vector>
+
+
+namespace mdl { namespace opencv {
+  /**
+   * Where each frame is in a YUV4MPEG2 (.y4m) file, and how it is
+   * laid out. Only 8-bit planar formats are supported: 4:2:0 (any
+   * chroma siting), 4:2:2, 4:4:4 and mono.
+   */
+  class Y4MIndex
+  {
+  public:
+    enum class Chroma { C420, C422, C444, MONO };
+
+    /** Throws VideoNotOpenedException if data is not a supported Y4M stream */
+    Y4MIndex(const char* data, std::size_t size);
+
+    /** Whether data starts like a Y4M stream */
+    static bool is_y4m(const char* data, std::size_t size);
+
+    int width() const;
+    int height() const;
+    double fps() const;
+    Chroma chroma() const;
+
+    int number_of_frames() const;
+    /** Bytes of the planes of a frame, Y followed by U and V */
+    std::size_t frame_size() const;
+    /** Offset of the Y plane of frame_number */
+    std::size_t frame_offset(int frame_number) const;
+
+  private:
+    int width_;
+    int height_;
+    double fps_;
+    Chroma chroma_;
+    std::size_t frame_size_;
+    std::vector<std::size_t> frame_offsets_;
+
+    static const char MAGIC_[];
+
+    void parse_parameter(const char* param, std::size_t length);
+  };
+} }
+
+
+#endif // MDL_OPENCV_Y4M_INDEX_H
@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <fstream>
+#include <vector>
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include "VideoSource.hpp"
+#include "MappedFile.hpp"
+#include "Y4MIndex.hpp"
+#include "Y4MVideoSource.hpp"
+
+using namespace mdl::opencv;
+
+
+Y4MVideoSource::Y4MVideoSource(const std::string& file)
+  : file_(file)
+  , index_(file_.data(), file_.size())
+  , next_frame_(0)
+  , frame_(-1)
+{
+}
+
+
+bool Y4MVideoSource::is_y4m_file(const std::string& file)
+{
+  std::ifstream in(file, std::ios::binary);
+  char magic[16];
+  in.read(magic, sizeof(magic));
+  return Y4MIndex::is_y4m(magic, in.gcount());
+}
+
+
+void Y4MVideoSource::seek(int frame_number)
+{
+  next_frame_ = frame_number;
+  frame_ = -1;
+}
+
+
+bool Y4MVideoSource::grab()
+{
+  if (next_frame_ < 0 || next_frame_ >= index_.number_of_frames()) {
+    frame_ = -1;
+    return false;
+  }
+
+  frame_ = next_frame_++;
+  return true;
+}
+
+
+bool Y4MVideoSource::retrieve(cv::Mat& frame)
+{
+  if (frame_ == -1) {
+    return false;
+  }
+
+  int width = index_.width();
+  int height = index_.height();
+  std::size_t offset = index_.frame_offset(frame_);
+
+  switch (index_.chroma()) {
+  case Y4MIndex::Chroma::MONO:
+    cv::cvtColor(plane(offset, width, height), frame, cv::COLOR_GRAY2BGR);
+    return true;
+
+  case Y4MIndex::Chroma::C420:
+    if (width % 2 == 0 && height % 2 == 0) {
+      // The three planes are contiguous, as OpenCV expects them
+      cv::cvtColor(plane(offset, width, height * 3 / 2), frame, cv::COLOR_YUV2BGR_I420);
+      return true;
+    }
+    break;
+
+  default:
+    break;
+  }
+
+  // Other layouts are rare in practice, so the chroma is just scaled
+  // to the size of the luma
+  int chroma_width = index_.chroma() == Y4MIndex::Chroma::C444 ? width : (width + 1) / 2;
+  int chroma_height = index_.chroma() == Y4MIndex::Chroma::C420 ? (height + 1) / 2 : height;
+  std::size_t chroma_size = static_cast<std::size_t>(chroma_width) * chroma_height;
+  std::size_t u_offset = offset + static_cast<std::size_t>(width) * height;
+
+  cv::Mat u, v;
+  cv::resize(plane(u_offset, chroma_width, chroma_height), u, cv::Size(width, height),
+             0, 0, cv::INTER_NEAREST);
+  cv::resize(plane(u_offset + chroma_size, chroma_width, chroma_height), v, cv::Size(width, height),
+             0, 0, cv::INTER_NEAREST);
+
+  cv::Mat ycrcb;
+  cv::merge(std::vector<cv::Mat>{plane(offset, width, height), v, u}, ycrcb);
+  cv::cvtColor(ycrcb, frame, cv::COLOR_YCrCb2BGR);
+  return true;
+}
+
+
+bool Y4MVideoSource::retrieve_luma(cv::Mat& luma)
+{
+  if (frame_ == -1) {
+    return false;
+  }
+
+  luma = plane(index_.frame_offset(frame_), index_.width(), index_.height());
+  return true;
+}
+
+
+int Y4MVideoSource::get_frame_width()
+{
+  return index_.width();
+}
+
+
+int Y4MVideoSource::get_frame_height()
+{
+  return index_.height();
+}
+
+
+int Y4MVideoSource::get_number_of_frames()
+{
+  return index_.number_of_frames();
+}
+
+
+double Y4MVideoSource::get_fps()
+{
+  return index_.fps();
+}
+
+
+/**
+ * A view of the file memory, which is read-only: the Mat must not be
+ * written to.
+ */
+cv::Mat Y4MVideoSource::plane(std::size_t offset, int width, int height) const
+{
+  return cv::Mat(height, width, CV_8UC1, const_cast<char*>(file_.data() + offset));
+}
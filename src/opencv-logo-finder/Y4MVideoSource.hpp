@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MDL_OPENCV_Y4M_VIDEO_SOURCE_H
+#define MDL_OPENCV_Y4M_VIDEO_SOURCE_H
+
+#include <string>
+
+#include <opencv2/core.hpp>
+
+#include "VideoSource.hpp"
+#include "MappedFile.hpp"
+#include "Y4MIndex.hpp"
+
+
+namespace mdl { namespace opencv {
+  /**
+   * Reads uncompressed YUV4MPEG2 files, mapped into memory. There is
+   * nothing to decode: the luma is a view of the file, and seeking
+   * only changes the next frame. Used by tests and benchmarks to
+   * measure the logo finder without the cost of the decoder.
+   */
+  class Y4MVideoSource : public VideoSource
+  {
+  public:
+    /** Throws VideoNotOpenedException */
+    explicit Y4MVideoSource(const std::string& file);
+
+    /** Whether file is a Y4M file, by its contents */
+    static bool is_y4m_file(const std::string& file);
+
+    void seek(int frame_number) override;
+    bool grab() override;
+    bool retrieve(cv::Mat& frame) override;
+    bool retrieve_luma(cv::Mat& luma) override;
+
+    int get_frame_width() override;
+    int get_frame_height() override;
+    int get_number_of_frames() override;
+    double get_fps() override;
+
+  private:
+    MappedFile file_;
+    Y4MIndex index_;
+    int next_frame_;
+    int frame_;
+
+    cv::Mat plane(std::size_t offset, int width, int height) const;
+  };
+} }
+
+
+#endif // MDL_OPENCV_Y4M_VIDEO_SOURCE_H
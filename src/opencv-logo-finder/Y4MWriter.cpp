@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <fstream>
+#include <cmath>
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include "gui/common/Exceptions.hpp"
+
+#include "Y4MWriter.hpp"
+
+using namespace mdl::opencv;
+
+
+Y4MWriter::Y4MWriter(const std::string& file, int width, int height, double fps)
+  : out_(file, std::ios::binary)
+{
+  if (!out_ || width % 2 != 0 || height % 2 != 0) {
+    throw VideoNotOpenedException();
+  }
+
+  // The frame rate is a fraction, with enough precision for 29.97
+  out_ << "YUV4MPEG2 W" << width << " H" << height
+       << " F" << std::lround(fps * 1000) << ":1000 Ip A1:1 C420jpeg\n";
+}
+
+
+void Y4MWriter::write(const cv::Mat& frame)
+{
+  cv::cvtColor(frame, yuv_, cv::COLOR_BGR2YUV_I420);
+
+  out_ << "FRAME\n";
+  out_.write(reinterpret_cast<const char*>(yuv_.data), yuv_.total());
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MDL_OPENCV_Y4M_WRITER_H
+#define MDL_OPENCV_Y4M_WRITER_H
+
+#include <string>
+#include <fstream>
+
+#include <opencv2/core.hpp>
+
+
+namespace mdl { namespace opencv {
+  /** Writes BGR frames to a 4:2:0 YUV4MPEG2 file */
+  class Y4MWriter
+  {
+  public:
+    /** Width and height must be even. Throws VideoNotOpenedException */
+    Y4MWriter(const std::string& file, int width, int height, double fps);
+
+    void write(const cv::Mat& frame);
+
+  private:
+    std::ofstream out_;
+    cv::Mat yuv_;
+  };
+} }
+
+
+#endif // MDL_OPENCV_Y4M_WRITER_H
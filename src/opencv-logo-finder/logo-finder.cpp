@@ -17,13 +17,18 @@
  * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <cstdlib>
+#include <string>
 #include <limits>
 #include <memory>
 #include <iostream>
 #include <fstream>
 
+#include <getopt.h>
+
 #include "filter-generator/FilterData.hpp"
 
+#include "gui/common/LogoFinderStats.hpp"
+
 #include "FilterListAdapter.hpp"
 
 using namespace mdl;
@@ -45,19 +50,104 @@ private:
 };
 
 
+static void usage()
+{
+  std::cout << "Usage: logo-finder [--stats=<file>] [--templates=<file>] [--track] [--scenes] [--progressive] [--pyramid] [--luma] <video> <output> <start_frame> <frame_interval_min> <frame_interval_max> [<end_frame>]" << std::endl
+            << "  --stats=<file>      write timing statistics as JSON to <file>, - for standard output" << std::endl
+            << "  --templates=<file>  use and update the library of known logos in <file>" << std::endl
+            << "  --track             follow each logo found until it changes" << std::endl
+            << "  --scenes            detect shot changes first, and look for logo changes only at them" << std::endl
+            << "  --progressive       stop averaging frames once the box found is stable" << std::endl
+            << "  --pyramid           search in a reduced frame first, for high resolution videos" << std::endl
+            << "  --luma              search only in the luma, instead of in each colour channel" << std::endl;
+}
+
+
+static bool write_stats(const std::string& stats_file, const LogoFinderStats& stats)
+{
+  if (stats_file == "-") {
+    stats.write_json(std::cout);
+    return true;
+  }
+
+  std::ofstream out(stats_file);
+  if (!out) {
+    std::cout << "Could not write statistics to " << stats_file << std::endl;
+    return false;
+  }
+  stats.write_json(out);
+  return true;
+}
+
+
 int main(int argc, char* argv[])
 {
-  if (argc < 5) {
-    std::cout << "Usage: logo-finder <video> <output> <start_frame> <frame_interval_min> <frame_interval_max> [<end_frame>]" << std::endl;
+  std::string stats_file;
+  std::string template_file;
+  bool tracking = false;
+  bool scene_detection = false;
+  bool progressive = false;
+  bool pyramid = false;
+  bool luma = false;
+
+  const struct option long_options[] = {
+    {"stats", required_argument, nullptr, 's'},
+    {"templates", required_argument, nullptr, 't'},
+    {"track", no_argument, nullptr, 'k'},
+    {"scenes", no_argument, nullptr, 'n'},
+    {"progressive", no_argument, nullptr, 'p'},
+    {"pyramid", no_argument, nullptr, 'y'},
+    {"luma", no_argument, nullptr, 'l'},
+    {"help", no_argument, nullptr, 'h'},
+    {nullptr, 0, nullptr, 0}
+  };
+
+  int opt;
+  while ((opt = getopt_long(argc, argv, "s:t:knpylh", long_options, nullptr)) != -1) {
+    switch (opt) {
+    case 's':
+      stats_file = optarg;
+      break;
+    case 't':
+      template_file = optarg;
+      break;
+    case 'k':
+      tracking = true;
+      break;
+    case 'n':
+      scene_detection = true;
+      break;
+    case 'p':
+      progressive = true;
+      break;
+    case 'y':
+      pyramid = true;
+      break;
+    case 'l':
+      luma = true;
+      break;
+    case 'h':
+      usage();
+      return 0;
+    default:
+      usage();
+      return 1;
+    }
+  }
+
+  char** args = argv + optind;
+  int n_args = argc - optind;
+  if (n_args < 5) {
+    usage();
     return 1;
   }
 
-  int start_frame = atoi(argv[3]) - 1;
-  int frame_interval_min = atoi(argv[4]);
-  int frame_interval_max = atoi(argv[5]);
+  int start_frame = atoi(args[2]) - 1;
+  int frame_interval_min = atoi(args[3]);
+  int frame_interval_max = atoi(args[4]);
 
   fg::FilterData filter_data;
-  filter_data.set_movie_file(argv[1]);
+  filter_data.set_movie_file(args[0]);
   filter_data.set_jump_size(frame_interval_min);
 
   MatcherCallback matcher_callback(frame_interval_min);
@@ -67,28 +157,39 @@ int main(int argc, char* argv[])
   finder->set_start_frame(start_frame);
   finder->set_frame_interval_min(frame_interval_min);
   finder->set_extra_frames(frame_interval_max - frame_interval_min);
+  finder->set_template_file(template_file);
+  finder->set_tracking(tracking);
+  finder->set_scene_detection(scene_detection);
+  finder->set_progressive(progressive);
+  finder->set_pyramid(pyramid);
+  finder->set_luma(luma);
 
   int end_frame;
-  if (argc == 7) {
-    end_frame = atoi(argv[6]);
+  if (n_args == 6) {
+    end_frame = atoi(args[5]);
   } else {
     end_frame = std::numeric_limits<int>::max();
   }
 
   matcher_callback.set_end_frame(end_frame);
+  finder->set_end_frame(end_frame);
   matcher_callback.set_finder(finder.get());
 
-  std::cout << "Processing video " << argv[1]
+  std::cout << "Processing video " << args[0]
             << " from " << start_frame << " until " << end_frame
             << ", interval " << frame_interval_min << "-" << frame_interval_max
-            << ", output " << argv[2]
+            << ", output " << args[1]
             << std::endl;
 
   auto res = finder->find_logos();
 
-  std::ofstream output(argv[2]);
+  std::ofstream output(args[1]);
   filter_data.save(output);
 
+  if (!stats_file.empty() && !write_stats(stats_file, finder->stats())) {
+    return 2;
+  }
+
   if (res.first) {
     std::cout << "Finished successfully" << std::endl;
   } else {
@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+
+#include <getopt.h>
+
+#include "filter-generator/FilterData.hpp"
+#include "filter-generator/FilterList.hpp"
+#include "filter-generator/Filters.hpp"
+
+#include "gui/common/Exceptions.hpp"
+#include "SyntheticClip.hpp"
+
+using namespace mdl;
+
+
+static void usage()
+{
+  std::cout << "Usage: make-test-clip [options] <script> <output.y4m>" << std::endl
+            << "Generates an uncompressed video with logos where the script says, one per line as" << std::endl
+            << "\"start_frame end_frame x y width height\", with frames starting at 0 and end_frame excluded." << std::endl
+            << "  --width=N           frame width (default 640)" << std::endl
+            << "  --height=N          frame height (default 360)" << std::endl
+            << "  --fps=N             frame rate (default 25)" << std::endl
+            << "  --scene-length=N    frames between background changes (default 40)" << std::endl
+            << "  --seed=N            seed for the background and noise" << std::endl
+            << "  --project=FILE      also write a project file with the correct filters" << std::endl;
+}
+
+
+/**
+ * A delogo filter for each logo, and a null filter where no logo
+ * follows, so that the project can be used as the truth for the
+ * benchmark.
+ */
+static void save_project(const std::string& file, const std::string& movie_file,
+                         const std::vector<opencv::ScriptedLogo>& script)
+{
+  fg::FilterData project;
+  project.set_movie_file(movie_file);
+
+  // The clip ends at the end of the last logo
+  int total_frames = 0;
+  for (const auto& logo: script) {
+    total_frames = std::max(total_frames, logo.end_frame);
+  }
+
+  // Logos starting where another ends replace its null filter
+  for (const auto& logo: script) {
+    if (logo.end_frame < total_frames) {
+      project.filter_list().insert(logo.end_frame + 1, fg::filter_ptr(new fg::NullFilter()));
+    }
+  }
+  for (const auto& logo: script) {
+    project.filter_list().insert(logo.start_frame + 1,
+                                 fg::filter_ptr(new fg::DelogoFilter(logo.logo.x, logo.logo.y,
+                                                                     logo.logo.width, logo.logo.height)));
+  }
+
+  std::ofstream out(file);
+  project.save(out);
+}
+
+
+int main(int argc, char* argv[])
+{
+  int width = 640;
+  int height = 360;
+  double fps = 25;
+  int scene_length = 40;
+  unsigned seed = 0;
+  bool has_seed = false;
+  std::string project_file;
+
+  const struct option long_options[] = {
+    {"width", required_argument, nullptr, 'W'},
+    {"height", required_argument, nullptr, 'H'},
+    {"fps", required_argument, nullptr, 'f'},
+    {"scene-length", required_argument, nullptr, 's'},
+    {"seed", required_argument, nullptr, 'r'},
+    {"project", required_argument, nullptr, 'p'},
+    {"help", no_argument, nullptr, 'h'},
+    {nullptr, 0, nullptr, 0}
+  };
+
+  int opt;
+  while ((opt = getopt_long(argc, argv, "h", long_options, nullptr)) != -1) {
+    switch (opt) {
+    case 'W':
+      width = atoi(optarg);
+      break;
+    case 'H':
+      height = atoi(optarg);
+      break;
+    case 'f':
+      fps = atof(optarg);
+      break;
+    case 's':
+      scene_length = atoi(optarg);
+      break;
+    case 'r':
+      seed = strtoul(optarg, nullptr, 0);
+      has_seed = true;
+      break;
+    case 'p':
+      project_file = optarg;
+      break;
+    case 'h':
+      usage();
+      return 0;
+    default:
+      usage();
+      return 1;
+    }
+  }
+
+  char** args = argv + optind;
+  int n_args = argc - optind;
+  if (n_args != 2) {
+    usage();
+    return 1;
+  }
+
+  std::ifstream script_in(args[0]);
+  if (!script_in) {
+    std::cout << "Could not open " << args[0] << std::endl;
+    return 2;
+  }
+  std::vector<opencv::ScriptedLogo> script;
+  if (!opencv::SyntheticClip::load_script(script_in, script) || script.empty()) {
+    std::cout << "Invalid script " << args[0] << std::endl;
+    return 2;
+  }
+
+  opencv::SyntheticClip clip(width, height, fps);
+  clip.set_scene_length(scene_length);
+  if (has_seed) {
+    clip.set_seed(seed);
+  }
+
+  try {
+    clip.write(args[1], script);
+  } catch (VideoNotOpenedException& e) {
+    std::cout << "Could not create " << args[1] << " (width and height must be even)" << std::endl;
+    return 2;
+  }
+
+  if (!project_file.empty()) {
+    save_project(project_file, args[1], script);
+  }
+
+  std::cout << "Wrote " << args[1] << std::endl;
+}
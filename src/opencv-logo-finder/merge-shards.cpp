@@ -0,0 +1,295 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstdlib>
+#include <string>
+#include <limits>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+
+#include <getopt.h>
+
+#include "filter-generator/FilterData.hpp"
+#include "filter-generator/FilterList.hpp"
+#include "filter-generator/Exceptions.hpp"
+
+#include "FilterListAdapter.hpp"
+
+using namespace mdl;
+
+
+/**
+ * Stops the search once an interval ends where one of the filters of
+ * the next shard starts. From there on, the search would repeat what
+ * the next shard already found.
+ */
+class SeamCallback : public LogoFinderCallback
+{
+public:
+  SeamCallback(const fg::FilterList& next_shard, int seam);
+  void success(const LogoFinderResult& result) override;
+  void failure(int start_frame, int end_frame) override;
+  void set_finder(LogoFinder* finder);
+
+  /** 1-based frame where the search met the next shard, or -1 */
+  int sync_frame() const;
+
+private:
+  const fg::FilterList& next_shard_;
+  int seam_;
+  int sync_frame_;
+  LogoFinder* finder_;
+
+  void check_sync(int next_start_frame);
+};
+
+
+struct Options
+{
+  int frame_interval_min;
+  int frame_interval_max;
+  bool tracking = false;
+  bool scene_detection = false;
+  bool progressive = false;
+  bool pyramid = false;
+  bool luma = false;
+};
+
+
+static void usage()
+{
+  std::cout << "Usage: merge-shards [--track] [--scenes] [--progressive] [--pyramid] [--luma] <video> <output> <frame_interval_min> <frame_interval_max> <shard>..." << std::endl
+            << "Combines the files generated by logo-finder for consecutive parts of a video." << std::endl
+            << "The options and intervals must be the same used to generate the shards." << std::endl
+            << "  --track             follow each logo found until it changes" << std::endl
+            << "  --scenes            detect shot changes first, and look for logo changes only at them" << std::endl
+            << "  --progressive       stop averaging frames once the box found is stable" << std::endl
+            << "  --pyramid           search in a reduced frame first, for high resolution videos" << std::endl
+            << "  --luma              search only in the luma, instead of in each colour channel" << std::endl;
+}
+
+
+static bool load_shard(const std::string& file, fg::FilterData& shard)
+{
+  std::ifstream in(file);
+  if (!in) {
+    std::cout << "Could not open " << file << std::endl;
+    return false;
+  }
+
+  try {
+    shard.load(in);
+  } catch (fg::Exception& e) {
+    std::cout << "Invalid data in file " << file << std::endl;
+    return false;
+  }
+
+  if (shard.filter_list().empty()) {
+    std::cout << file << " has no filters" << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+
+/**
+ * The last filter of the list before the seam may have been cut
+ * short, or may be repeated in the next shard. The search is run
+ * again from its start, as it would be in a single run over the
+ * whole video, until it gets in step with the next shard.
+ */
+static bool merge_shard(fg::FilterData& merged, const fg::FilterList& shard,
+                        const Options& options)
+{
+  int seam = shard.begin()->first;
+
+  auto before_seam = merged.filter_list().get_filter_for_frame(seam - 1);
+  if (!before_seam) {
+    merged.filter_list().merge(shard, seam);
+    return true;
+  }
+  int rerun_start = before_seam->first;
+
+  fg::FilterData rerun;
+  rerun.set_movie_file(merged.movie_file());
+
+  SeamCallback seam_callback(shard, seam);
+  std::shared_ptr<LogoFinder> finder = create_logo_finder(rerun, seam_callback, false);
+  finder->set_start_frame(rerun_start - 1);
+  finder->set_end_frame(std::numeric_limits<int>::max());
+  finder->set_frame_interval_min(options.frame_interval_min);
+  finder->set_extra_frames(options.frame_interval_max - options.frame_interval_min);
+  finder->set_tracking(options.tracking);
+  finder->set_scene_detection(options.scene_detection);
+  finder->set_progressive(options.progressive);
+  finder->set_pyramid(options.pyramid);
+  finder->set_luma(options.luma);
+  seam_callback.set_finder(finder.get());
+
+  auto res = finder->find_logos();
+  if (!res.first) {
+    std::cout << "Error: " << res.second << std::endl;
+    return false;
+  }
+
+  merged.filter_list().merge(rerun.filter_list(), rerun_start);
+  if (seam_callback.sync_frame() != -1) {
+    merged.filter_list().merge(shard, seam_callback.sync_frame());
+    std::cout << "Seam at " << seam << ": searched again frames "
+              << rerun_start << "-" << seam_callback.sync_frame() - 1 << std::endl;
+  } else {
+    std::cout << "Seam at " << seam << ": searched again from frame "
+              << rerun_start << " until the end" << std::endl;
+  }
+
+  return true;
+}
+
+
+int main(int argc, char* argv[])
+{
+  Options options;
+
+  const struct option long_options[] = {
+    {"track", no_argument, nullptr, 'k'},
+    {"scenes", no_argument, nullptr, 'n'},
+    {"progressive", no_argument, nullptr, 'p'},
+    {"pyramid", no_argument, nullptr, 'y'},
+    {"luma", no_argument, nullptr, 'l'},
+    {"help", no_argument, nullptr, 'h'},
+    {nullptr, 0, nullptr, 0}
+  };
+
+  int opt;
+  while ((opt = getopt_long(argc, argv, "knpylh", long_options, nullptr)) != -1) {
+    switch (opt) {
+    case 'k':
+      options.tracking = true;
+      break;
+    case 'n':
+      options.scene_detection = true;
+      break;
+    case 'p':
+      options.progressive = true;
+      break;
+    case 'y':
+      options.pyramid = true;
+      break;
+    case 'l':
+      options.luma = true;
+      break;
+    case 'h':
+      usage();
+      return 0;
+    default:
+      usage();
+      return 1;
+    }
+  }
+
+  char** args = argv + optind;
+  int n_args = argc - optind;
+  if (n_args < 5) {
+    usage();
+    return 1;
+  }
+
+  options.frame_interval_min = atoi(args[2]);
+  options.frame_interval_max = atoi(args[3]);
+
+  std::vector<std::unique_ptr<fg::FilterData>> shards;
+  for (int i = 4; i < n_args; ++i) {
+    std::unique_ptr<fg::FilterData> shard(new fg::FilterData());
+    if (!load_shard(args[i], *shard)) {
+      return 2;
+    }
+    shards.push_back(std::move(shard));
+  }
+
+  std::sort(shards.begin(), shards.end(),
+    [](const auto& shard1, const auto& shard2) {
+      return shard1->filter_list().begin()->first < shard2->filter_list().begin()->first;
+    });
+
+  fg::FilterData merged;
+  merged.set_movie_file(args[0]);
+  merged.set_jump_size(shards.front()->jump_size());
+  merged.filter_list().merge(shards.front()->filter_list(), 1);
+
+  for (std::size_t i = 1; i < shards.size(); ++i) {
+    if (!merge_shard(merged, shards[i]->filter_list(), options)) {
+      return 2;
+    }
+  }
+
+  std::ofstream output(args[1]);
+  merged.save(output);
+  output.close();
+  if (!output) {
+    std::cout << "Could not write " << args[1] << std::endl;
+    return 2;
+  }
+
+  std::cout << "Merged " << shards.size() << " shards into " << args[1] << std::endl;
+}
+
+
+SeamCallback::SeamCallback(const fg::FilterList& next_shard, int seam)
+  : next_shard_(next_shard)
+  , seam_(seam)
+  , sync_frame_(-1)
+  , finder_(nullptr)
+{
+}
+
+
+void SeamCallback::success(const LogoFinderResult& result)
+{
+  check_sync(result.end_frame + 2);
+}
+
+
+void SeamCallback::failure(int start_frame, int end_frame)
+{
+  check_sync(end_frame + 2);
+}
+
+
+void SeamCallback::set_finder(LogoFinder* finder)
+{
+  finder_ = finder;
+}
+
+
+int SeamCallback::sync_frame() const
+{
+  return sync_frame_;
+}
+
+
+void SeamCallback::check_sync(int next_start_frame)
+{
+  if (next_start_frame >= seam_ && next_shard_.get_by_start_frame(next_start_frame)) {
+    sync_frame_ = next_start_frame;
+    finder_->stop();
+  }
+}
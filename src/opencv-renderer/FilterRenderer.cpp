@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "filter-generator/Filters.hpp"
+
+#include "FilterRenderer.hpp"
+
+using namespace mdl::opencv;
+
+
+void FilterRenderer::render(const fg::Filter& filter, ImageBuffer& image)
+{
+  switch (filter.type()) {
+  case fg::FilterType::DELOGO:
+    {
+      const fg::RectangularFilter& r = static_cast<const fg::RectangularFilter&>(filter);
+      // Same adjustment done by DelogoFilter::ffmpeg_str
+      int adj_x      = std::max(r.x(), 1);
+      int adj_y      = std::max(r.y(), 1);
+      int adj_width  = std::min(r.width(),  image.width  - adj_x - 1);
+      int adj_height = std::min(r.height(), image.height - adj_y - 1);
+      delogo(image, adj_x, adj_y, adj_width, adj_height);
+    }
+    break;
+
+  case fg::FilterType::DRAWBOX:
+    {
+      const fg::RectangularFilter& r = static_cast<const fg::RectangularFilter&>(filter);
+      drawbox(image, r.x(), r.y(), r.width(), r.height());
+    }
+    break;
+
+  default:
+    break;
+  }
+}
+
+
+/*
+ * Port of apply_delogo() from ffmpeg's vf_delogo.c, with band = 1 and
+ * a square aspect ratio. The pixels inside the rectangle are replaced
+ * by a weighted interpolation of the pixels on the border around it,
+ * each border sample being the sum of 3 neighbouring pixels. Only the
+ * inside of the border is written, so it can be done in place.
+ */
+void FilterRenderer::delogo(ImageBuffer& image, int x, int y, int width, int height)
+{
+  const int left   = std::max(x - 1, 0);
+  const int top    = std::max(y - 1, 0);
+  const int right  = std::min(x + width, image.width - 1);
+  const int bottom = std::min(y + height, image.height - 1);
+  if (right - left < 2 || bottom - top < 2) {
+    return;
+  }
+
+  const int step = image.channels;
+  const int stride = image.stride;
+
+  for (int c = 0; c < image.channels; ++c) {
+    const unsigned char* top_row    = image.data + top * stride + c;
+    const unsigned char* bottom_row = image.data + bottom * stride + c;
+
+    for (int py = top + 1; py < bottom; ++py) {
+      const unsigned char* row = image.data + py * stride + c;
+      uint64_t left_sample  = row[left * step - stride] + row[left * step] + row[left * step + stride];
+      uint64_t right_sample = row[right * step - stride] + row[right * step] + row[right * step + stride];
+
+      unsigned char* dst = image.data + py * stride + c;
+      for (int px = left + 1; px < right; ++px) {
+        uint64_t weight_l = (uint64_t) (right - px) * (py - top) * (bottom - py);
+        uint64_t weight_r = (uint64_t) (px - left) * (py - top) * (bottom - py);
+        uint64_t weight_t = (uint64_t) (px - left) * (right - px) * (bottom - py);
+        uint64_t weight_b = (uint64_t) (px - left) * (right - px) * (py - top);
+
+        uint64_t top_sample = top_row[(px - 1) * step] + top_row[px * step] + top_row[(px + 1) * step];
+        uint64_t bottom_sample = bottom_row[(px - 1) * step] + bottom_row[px * step] + bottom_row[(px + 1) * step];
+
+        uint64_t interp = left_sample * weight_l
+                        + right_sample * weight_r
+                        + top_sample * weight_t
+                        + bottom_sample * weight_b;
+        uint64_t weight = (weight_l + weight_r + weight_t + weight_b) * 3;
+
+        dst[px * step] = (interp + (weight >> 1)) / weight;
+      }
+    }
+  }
+}
+
+
+/*
+ * As in ffmpeg's drawbox, a width or height of 0 means the whole frame.
+ */
+void FilterRenderer::drawbox(ImageBuffer& image, int x, int y, int width, int height)
+{
+  if (width == 0) {
+    width = image.width;
+  }
+  if (height == 0) {
+    height = image.height;
+  }
+
+  int x0 = std::max(x, 0);
+  int y0 = std::max(y, 0);
+  int x1 = std::min(x + width, image.width);
+  int y1 = std::min(y + height, image.height);
+  if (x1 <= x0 || y1 <= y0) {
+    return;
+  }
+
+  for (int py = y0; py < y1; ++py) {
+    unsigned char* row = image.data + py * image.stride;
+    memset(row + x0 * image.channels, 0, (x1 - x0) * image.channels);
+  }
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MDL_OPENCV_FILTER_RENDERER_H
+#define MDL_OPENCV_FILTER_RENDERER_H
+
+#include "filter-generator/Filters.hpp"
+
+
+namespace mdl { namespace opencv {
+  /**
+   * An 8 bit interleaved image, such as a BGR cv::Mat or an RGB
+   * Gdk::Pixbuf. The renderer works on it in place.
+   */
+  struct ImageBuffer
+  {
+    unsigned char* data;
+    int width;
+    int height;
+    int stride;
+    int channels;
+  };
+
+
+  /**
+   * Applies filters to a frame the way ffmpeg does it for the script
+   * generated by RegularScriptGenerator. Filters that don't change
+   * the image (including cuts) are ignored.
+   */
+  class FilterRenderer
+  {
+  public:
+    static void render(const fg::Filter& filter, ImageBuffer& image);
+
+    static void delogo(ImageBuffer& image, int x, int y, int width, int height);
+    static void drawbox(ImageBuffer& image, int x, int y, int width, int height);
+  };
+} }
+
+
+#endif // MDL_OPENCV_FILTER_RENDERER_H
@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <vector>
+#include <ostream>
+#include <thread>
+
+#include <opencv2/core.hpp>
+#include <opencv2/videoio.hpp>
+
+#include "filter-generator/FilterList.hpp"
+#include "filter-generator/Filters.hpp"
+
+#include "gui/common/Exceptions.hpp"
+
+#include "FilterRenderer.hpp"
+#include "OpenCVRenderer.hpp"
+
+using namespace mdl::opencv;
+
+
+RawFrameSink::RawFrameSink(std::ostream& out)
+  : out_(out)
+{
+}
+
+
+void RawFrameSink::write(const cv::Mat& frame)
+{
+  for (int row = 0; row < frame.rows; ++row) {
+    out_.write(frame.ptr<char>(row), frame.cols * frame.elemSize());
+  }
+}
+
+
+VideoFrameSink::VideoFrameSink(const std::string& file, double fps, int width, int height)
+{
+  int fourcc = cv::VideoWriter::fourcc('M', 'J', 'P', 'G');
+  writer_.open(file, fourcc, fps, cv::Size(width, height));
+  if (!writer_.isOpened()) {
+    throw mdl::VideoNotOpenedException();
+  }
+}
+
+
+void VideoFrameSink::write(const cv::Mat& frame)
+{
+  writer_.write(frame);
+}
+
+
+OpenCVRenderer::OpenCVRenderer(const std::string& file, const fg::FilterList& filter_list)
+  : filter_list_(filter_list)
+  , batch_size_(2 * std::max(std::thread::hardware_concurrency(), 1u))
+{
+  cap_.open(file);
+  if (!cap_.isOpened()) {
+    throw mdl::VideoNotOpenedException();
+  }
+}
+
+
+int OpenCVRenderer::get_frame_width() const
+{
+  return cap_.get(cv::CAP_PROP_FRAME_WIDTH);
+}
+
+
+int OpenCVRenderer::get_frame_height() const
+{
+  return cap_.get(cv::CAP_PROP_FRAME_HEIGHT);
+}
+
+
+int OpenCVRenderer::get_number_of_frames() const
+{
+  return cap_.get(cv::CAP_PROP_FRAME_COUNT);
+}
+
+
+double OpenCVRenderer::get_fps() const
+{
+  return cap_.get(cv::CAP_PROP_FPS);
+}
+
+
+void OpenCVRenderer::set_batch_size(int batch_size)
+{
+  batch_size_ = batch_size;
+}
+
+
+int OpenCVRenderer::render(FrameSink& sink, int start_frame, int end_frame)
+{
+  batch_.resize(batch_size_);
+  batch_filters_.resize(batch_size_);
+
+  cap_.set(cv::CAP_PROP_POS_FRAMES, start_frame);
+
+  // Filter list keys are frame numbers starting at 1
+  auto next = filter_list_.begin();
+  fg::filter_ptr current;
+
+  int frames_written = 0;
+  int n_frames = 0;
+  for (int frame = start_frame; frame < end_frame; ++frame) {
+    while (next != filter_list_.end() && next->first - 1 <= frame) {
+      current = next->second;
+      ++next;
+    }
+
+    if (current && current->type() == fg::FilterType::CUT) {
+      if (!cap_.grab()) {
+        throw mdl::FrameNotAvailableException(frame);
+      }
+      continue;
+    }
+
+    if (!cap_.read(batch_[n_frames])) {
+      throw mdl::FrameNotAvailableException(frame);
+    }
+    batch_filters_[n_frames] = current;
+    ++n_frames;
+
+    if (n_frames == batch_size_) {
+      render_batch(n_frames);
+      for (int i = 0; i < n_frames; ++i) {
+        sink.write(batch_[i]);
+      }
+      frames_written += n_frames;
+      n_frames = 0;
+    }
+  }
+
+  render_batch(n_frames);
+  for (int i = 0; i < n_frames; ++i) {
+    sink.write(batch_[i]);
+  }
+  frames_written += n_frames;
+
+  return frames_written;
+}
+
+
+void OpenCVRenderer::render_batch(int n_frames)
+{
+  cv::parallel_for_(cv::Range(0, n_frames), [this](const cv::Range& range) {
+      for (int i = range.start; i < range.end; ++i) {
+        if (!batch_filters_[i]) {
+          continue;
+        }
+
+        cv::Mat& frame = batch_[i];
+        ImageBuffer image{.data = frame.data,
+                          .width = frame.cols, .height = frame.rows,
+                          .stride = (int) frame.step, .channels = frame.channels()};
+        FilterRenderer::render(*batch_filters_[i], image);
+      }
+    });
+}
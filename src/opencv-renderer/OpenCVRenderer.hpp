@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MDL_OPENCV_OPENCV_RENDERER_H
+#define MDL_OPENCV_OPENCV_RENDERER_H
+
+#include <string>
+#include <vector>
+#include <ostream>
+
+#include <opencv2/core.hpp>
+#include <opencv2/videoio.hpp>
+
+#include "filter-generator/FilterList.hpp"
+
+
+namespace mdl { namespace opencv {
+  class FrameSink
+  {
+  public:
+    virtual ~FrameSink() { }
+
+    virtual void write(const cv::Mat& frame) = 0;
+  };
+
+
+  /** Writes frames as bgr24 rawvideo */
+  class RawFrameSink : public FrameSink
+  {
+  public:
+    RawFrameSink(std::ostream& out);
+
+    void write(const cv::Mat& frame) override;
+
+  private:
+    std::ostream& out_;
+  };
+
+
+  class VideoFrameSink : public FrameSink
+  {
+  public:
+    VideoFrameSink(const std::string& file, double fps, int width, int height);
+
+    void write(const cv::Mat& frame) override;
+
+  private:
+    cv::VideoWriter writer_;
+  };
+
+
+  /**
+   * Applies a filter list to a video without calling ffmpeg. Frames
+   * are decoded sequentially and filtered in parallel, in batches.
+   */
+  class OpenCVRenderer
+  {
+  public:
+    OpenCVRenderer(const std::string& file, const fg::FilterList& filter_list);
+
+    int get_frame_width() const;
+    int get_frame_height() const;
+    int get_number_of_frames() const;
+    double get_fps() const;
+
+    void set_batch_size(int batch_size);
+
+    /**
+     * Renders frames [start_frame, end_frame), numbered from 0.
+     * Frames inside cuts are skipped. Returns the number of frames
+     * written.
+     */
+    int render(FrameSink& sink, int start_frame, int end_frame);
+
+  private:
+    mutable cv::VideoCapture cap_;
+    const fg::FilterList& filter_list_;
+    int batch_size_;
+
+    std::vector<cv::Mat> batch_;
+    std::vector<fg::filter_ptr> batch_filters_;
+
+    void render_batch(int n_frames);
+  };
+} }
+
+
+#endif // MDL_OPENCV_OPENCV_RENDERER_H
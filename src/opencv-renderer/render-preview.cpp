@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstdlib>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <iostream>
+#include <fstream>
+
+#include <boost/algorithm/string/predicate.hpp>
+
+#include "filter-generator/FilterData.hpp"
+#include "filter-generator/Exceptions.hpp"
+
+#include "gui/common/Exceptions.hpp"
+
+#include "OpenCVRenderer.hpp"
+
+using namespace mdl::opencv;
+
+
+int main(int argc, char* argv[])
+{
+  if (argc < 3) {
+    std::cerr << "Usage: render-preview <project> <output> [<first_frame> [<last_frame>]]" << std::endl
+              << "Output is written as bgr24 rawvideo if it is - or ends with .raw," << std::endl
+              << "otherwise as MJPEG." << std::endl;
+    return 1;
+  }
+
+  fg::FilterData filter_data;
+  std::ifstream project(argv[1]);
+  if (!project.is_open()) {
+    std::cerr << "Could not open " << argv[1] << std::endl;
+    return 2;
+  }
+  try {
+    filter_data.load(project);
+  } catch (fg::Exception& e) {
+    std::cerr << "Invalid data in file " << argv[1] << std::endl;
+    return 2;
+  }
+
+  try {
+    OpenCVRenderer renderer(filter_data.movie_file(), filter_data.filter_list());
+
+    int first_frame = argc > 3 ? atoi(argv[3]) : 1;
+    int last_frame = argc > 4 ? atoi(argv[4]) : renderer.get_number_of_frames();
+
+    std::string output(argv[2]);
+    std::unique_ptr<std::ofstream> raw_file;
+    std::unique_ptr<FrameSink> sink;
+    if (output == "-") {
+      sink.reset(new RawFrameSink(std::cout));
+    } else if (boost::algorithm::ends_with(output, ".raw")) {
+      raw_file.reset(new std::ofstream(output, std::ios::binary));
+      if (!raw_file->is_open()) {
+        std::cerr << "Could not open " << output << std::endl;
+        return 2;
+      }
+      sink.reset(new RawFrameSink(*raw_file));
+    } else {
+      sink.reset(new VideoFrameSink(output, renderer.get_fps(),
+                                    renderer.get_frame_width(), renderer.get_frame_height()));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    int frames = renderer.render(*sink, first_frame - 1, last_frame);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    if (raw_file) {
+      raw_file->close();
+    }
+    if ((raw_file && raw_file->fail()) || (output == "-" && !std::cout.flush())) {
+      std::cerr << "Could not write " << output << std::endl;
+      return 2;
+    }
+
+    std::cerr << "Rendered " << frames << " frames in " << elapsed.count() << "s ("
+              << frames / elapsed.count() << " fps)" << std::endl;
+  } catch (mdl::VideoNotOpenedException& e) {
+    std::cerr << "Could not open video " << filter_data.movie_file() << std::endl;
+    return 2;
+  } catch (mdl::FrameNotAvailableException& e) {
+    std::cerr << "Could not get frame " << e.get_frame() << std::endl;
+    return 3;
+  }
+
+  return 0;
+}
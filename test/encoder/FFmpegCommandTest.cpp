@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <vector>
+
+#include "filter-generator/FilterList.hpp"
+#include "filter-generator/Filters.hpp"
+#include "filter-generator/RegularScriptGenerator.hpp"
+
+#include "FFmpegCommand.hpp"
+
+using namespace mdl;
+
+
+#define BOOST_TEST_MODULE FFmpeg command
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "../TestHelpers.hpp"
+
+
+struct FFmpegCommandFixture
+{
+  FFmpegCommandFixture()
+  {
+    command.set_generator(fg::RegularScriptGenerator::create(filters, 1920, 1080, 25, boost::none, boost::none));
+    command.set_input_file("input.mp4");
+    command.set_output_file("output.mkv");
+  }
+
+  fg::FilterList filters;
+  FFmpegCommand command;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE(ffmpeg_command_line, FFmpegCommandFixture)
+
+BOOST_AUTO_TEST_CASE(test_default_settings)
+{
+  std::vector<std::string> expected{
+    "ffmpeg",
+    "-y",
+    "-i", "input.mp4",
+    "-/filter_complex", "filters.ffm",
+    "-map", "[out_v]", "-c:v", "libx264", "-crf", "23",
+    "-map", "0:a?", "-c:a", "copy",
+    "-preset", "medium",
+    "output.mkv"};
+  BOOST_TEST(command.get_cmd_line("filters.ffm") == expected,
+             boost::test_tools::per_element());
+}
+
+
+BOOST_AUTO_TEST_CASE(test_h265_reencode_audio_mp4)
+{
+  filters.insert(1000, fg::filter_ptr(new fg::CutFilter()));
+  command.set_codec(FFmpegCommand::Codec::H265);
+  command.set_quality(30);
+  command.set_preset("veryslow");
+  command.set_output_file("output.mp4");
+
+  std::vector<std::string> expected{
+    "ffmpeg",
+    "-y",
+    "-i", "input.mp4",
+    "-/filter_complex", "filters.ffm",
+    "-map", "[out_v]", "-c:v", "libx265", "-crf", "30",
+    "-map", "[out_a]", "-c:a", "aac", "-b:a", "192k",
+    "-preset", "veryslow",
+    "-movflags", "+faststart",
+    "output.mp4"};
+  BOOST_TEST(command.get_cmd_line("filters.ffm") == expected,
+             boost::test_tools::per_element());
+}
+
+
+BOOST_AUTO_TEST_CASE(test_input_range_reencode_audio)
+{
+  command.set_input_range(39.98, 60);
+  command.set_reencode_audio(true);
+
+  std::vector<std::string> expected{
+    "ffmpeg",
+    "-y",
+    "-ss", "39.980000", "-t", "60.000000",
+    "-i", "input.mp4",
+    "-/filter_complex", "filters.ffm",
+    "-map", "[out_v]", "-c:v", "libx264", "-crf", "23",
+    "-map", "0:a?", "-c:a", "aac", "-b:a", "192k",
+    "-preset", "medium",
+    "output.mkv"};
+  BOOST_TEST(command.get_cmd_line("filters.ffm") == expected,
+             boost::test_tools::per_element());
+}
+
+
+BOOST_AUTO_TEST_CASE(test_concat)
+{
+  command.set_output_file("output.mp4");
+
+  std::vector<std::string> expected{
+    "ffmpeg",
+    "-y",
+    "-f", "concat", "-safe", "0", "-i", "segments.ffconcat",
+    "-map", "0", "-c", "copy",
+    "-movflags", "+faststart",
+    "output.mp4"};
+  BOOST_TEST(command.get_concat_cmd_line("segments.ffconcat") == expected,
+             boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+
+BOOST_AUTO_TEST_CASE(should_get_frames_encoded)
+{
+  int frames = FFmpegCommand::get_frames_encoded("frame=  4238 fps= 36 q=31.0 size=    2048kB time=00:00:19.06 bitrate= 880.1kbits/s speed=0.605x");
+  BOOST_TEST(frames == 4238);
+}
+
+
+BOOST_AUTO_TEST_CASE(should_return_negative_for_line_without_frames)
+{
+  BOOST_TEST(FFmpegCommand::get_frames_encoded("Some random string") == -1);
+  BOOST_TEST(FFmpegCommand::get_frames_encoded("") == -1);
+}
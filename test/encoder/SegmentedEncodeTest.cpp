@@ -0,0 +1,226 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstdlib>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <fstream>
+
+#include <unistd.h>
+
+#include "filter-generator/FilterList.hpp"
+#include "filter-generator/Filters.hpp"
+#include "filter-generator/RegularScriptGenerator.hpp"
+
+#include "FFmpegCommand.hpp"
+#include "SegmentedEncode.hpp"
+
+using namespace mdl;
+
+
+#define BOOST_TEST_MODULE segmented encode
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "../TestHelpers.hpp"
+
+
+struct SegmentedEncodeFixture
+{
+  SegmentedEncodeFixture()
+  {
+    char dir_template[] = "/tmp/mdl-segments-XXXXXX";
+    work_dir = mkdtemp(dir_template);
+
+    command.set_input_file("input.mp4");
+    command.set_output_file("output.mp4");
+
+    filters.insert(1, fg::filter_ptr(new fg::NullFilter()));
+    filters.insert(50, fg::filter_ptr(new fg::DelogoFilter(10, 11, 12, 13)));
+    filters.insert(120, fg::filter_ptr(new fg::DrawboxFilter(20, 21, 22, 23)));
+    filters.insert(180, fg::filter_ptr(new fg::NullFilter()));
+  }
+
+  ~SegmentedEncodeFixture()
+  {
+    std::remove((work_dir + "/manifest").c_str());
+    std::remove((work_dir + "/segments.ffconcat").c_str());
+    for (const auto& file: created_files) {
+      std::remove(file.c_str());
+    }
+    rmdir(work_dir.c_str());
+  }
+
+  std::shared_ptr<SegmentedEncode> create()
+  {
+    return std::make_shared<SegmentedEncode>(filters, command, 640, 480, 25, 250,
+                                             boost::none, boost::none, false,
+                                             work_dir, 100);
+  }
+
+  void encode_all(SegmentedEncode& encode)
+  {
+    for (std::size_t i = 0; i < encode.segments().size(); ++i) {
+      std::ofstream(encode.segments()[i].file) << "encoded";
+      created_files.push_back(encode.segments()[i].file);
+      encode.mark_encoded(i);
+    }
+  }
+
+  std::string work_dir;
+  std::vector<std::string> created_files;
+  fg::FilterList filters;
+  FFmpegCommand command;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE(segmented_encode, SegmentedEncodeFixture)
+
+BOOST_AUTO_TEST_CASE(should_split_in_segments)
+{
+  auto encode = create();
+  const auto& segments = encode->segments();
+
+  BOOST_TEST(segments.size() == 3);
+  BOOST_TEST(segments[0].start_frame == 0);
+  BOOST_TEST(segments[0].end_frame == 100);
+  BOOST_TEST(segments[1].start_frame == 100);
+  BOOST_TEST(segments[1].end_frame == 200);
+  BOOST_TEST(segments[2].start_frame == 200);
+  BOOST_TEST(segments[2].end_frame == 250);
+  BOOST_TEST(segments[2].output_frames == 50);
+  BOOST_TEST(segments[0].file == work_dir + "/segment-00000000.mkv");
+
+  BOOST_TEST(encode->frames_to_encode() == 250);
+}
+
+
+BOOST_AUTO_TEST_CASE(should_rebase_filters_to_the_segment)
+{
+  auto encode = create();
+  const fg::FilterList& second = *encode->segments()[1].filter_list;
+
+  BOOST_TEST(second.size() == 3);
+  BOOST_TEST(second.get_by_start_frame(1)->second->type() == fg::FilterType::DELOGO);
+  BOOST_TEST(second.get_by_start_frame(20)->second->type() == fg::FilterType::DRAWBOX);
+  BOOST_TEST(second.get_by_start_frame(80)->second->type() == fg::FilterType::NO_OP);
+
+  BOOST_TEST(encode->segments()[2].script == "[0:v]null[out_v]");
+}
+
+
+BOOST_AUTO_TEST_CASE(should_seek_to_the_segment)
+{
+  auto encode = create();
+  std::vector<std::string> cmd_line = encode->get_segment_cmd_line(encode->segments()[1], "f.ffm");
+
+  BOOST_TEST(cmd_line[2] == "-ss");
+  BOOST_TEST(cmd_line[3] == "3.980000");
+  BOOST_TEST(cmd_line[4] == "-t");
+  BOOST_TEST(cmd_line[5] == "4.000000");
+  BOOST_TEST(cmd_line.back() == work_dir + "/segment-00000100.mkv");
+}
+
+
+BOOST_AUTO_TEST_CASE(should_skip_segments_completely_cut)
+{
+  filters.remove(120);
+  filters.remove(180);
+  filters.insert(210, fg::filter_ptr(new fg::CutFilter()));
+  filters.insert(90, fg::filter_ptr(new fg::CutFilter()));
+  filters.insert(201, fg::filter_ptr(new fg::NullFilter()));
+  auto encode = create();
+  const auto& segments = encode->segments();
+
+  BOOST_TEST(segments.size() == 2);
+  BOOST_TEST(segments[0].start_frame == 0);
+  BOOST_TEST(segments[0].output_frames == 89);
+  BOOST_TEST(segments[1].start_frame == 200);
+  BOOST_TEST(segments[1].output_frames == 9);
+}
+
+
+BOOST_AUTO_TEST_CASE(should_reuse_segments_already_encoded)
+{
+  encode_all(*create());
+
+  auto encode = create();
+  for (const auto& segment: encode->segments()) {
+    BOOST_TEST(segment.up_to_date);
+  }
+  BOOST_TEST(encode->frames_to_encode() == 0);
+}
+
+
+BOOST_AUTO_TEST_CASE(should_encode_only_segments_that_changed)
+{
+  encode_all(*create());
+
+  filters.insert(130, fg::filter_ptr(new fg::DrawboxFilter(30, 31, 32, 33)));
+  auto encode = create();
+  BOOST_TEST(encode->segments()[0].up_to_date);
+  BOOST_TEST(!encode->segments()[1].up_to_date);
+  BOOST_TEST(encode->segments()[2].up_to_date);
+  BOOST_TEST(encode->frames_to_encode() == 100);
+}
+
+
+BOOST_AUTO_TEST_CASE(should_encode_again_when_settings_change)
+{
+  encode_all(*create());
+
+  command.set_quality(18);
+  auto encode = create();
+  BOOST_TEST(encode->frames_to_encode() == 250);
+}
+
+
+BOOST_AUTO_TEST_CASE(should_encode_again_if_segment_file_is_missing)
+{
+  encode_all(*create());
+  std::remove((work_dir + "/segment-00000200.mkv").c_str());
+
+  auto encode = create();
+  BOOST_TEST(!encode->segments()[2].up_to_date);
+  BOOST_TEST(encode->frames_to_encode() == 50);
+}
+
+
+BOOST_AUTO_TEST_CASE(should_write_concat_list)
+{
+  auto encode = create();
+  encode->write_concat_list();
+
+  std::ifstream in(work_dir + "/segments.ffconcat");
+  std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  BOOST_TEST(contents ==
+             "ffconcat version 1.0\n"
+             "file 'segment-00000000.mkv'\n"
+             "file 'segment-00000100.mkv'\n"
+             "file 'segment-00000200.mkv'\n");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+
+BOOST_AUTO_TEST_CASE(should_hash_with_fnv1a)
+{
+  BOOST_TEST(SegmentedEncode::hash("") == "cbf29ce484222325");
+  BOOST_TEST(SegmentedEncode::hash("a") == "af63dc4c8601ec8c");
+}
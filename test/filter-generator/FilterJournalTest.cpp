@@ -0,0 +1,246 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstdlib>
+#include <cstdio>
+#include <string>
+#include <sstream>
+#include <fstream>
+
+#include <unistd.h>
+
+#include "Exceptions.hpp"
+#include "Filters.hpp"
+#include "FilterList.hpp"
+#include "FilterData.hpp"
+#include "FilterJournal.hpp"
+
+using namespace fg;
+
+
+#define BOOST_TEST_MODULE filter journal
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "../TestHelpers.hpp"
+
+
+struct JournalFixture
+{
+  JournalFixture()
+  {
+    char dir_template[] = "/tmp/mdl-journal-XXXXXX";
+    work_dir = mkdtemp(dir_template);
+    project_file = work_dir + "/project.mdl";
+
+    filter_data.set_movie_file("movie.mp4");
+    filter_data.filter_list().insert(1, filter_ptr(new NullFilter()));
+    filter_data.filter_list().insert(50, filter_ptr(new DelogoFilter(10, 11, 12, 13)));
+    filter_data.filter_list().insert(120, filter_ptr(new DrawboxFilter(20, 21, 22, 23)));
+  }
+
+  ~JournalFixture()
+  {
+    FilterJournal::remove(project_file);
+    rmdir(work_dir.c_str());
+  }
+
+  /** What would be loaded from the project file */
+  std::string saved()
+  {
+    std::ostringstream out;
+    filter_data.save(out);
+    return out.str();
+  }
+
+  std::string recovered(const std::string& base)
+  {
+    std::istringstream in(base);
+    FilterData recovered;
+    recovered.load(in);
+    FilterJournal::replay(project_file, recovered);
+
+    std::ostringstream out;
+    recovered.save(out);
+    return out.str();
+  }
+
+  std::string work_dir;
+  std::string project_file;
+  FilterData filter_data;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE(journal, JournalFixture)
+
+BOOST_AUTO_TEST_CASE(replay_should_recover_the_changes)
+{
+  std::string base = saved();
+
+  FilterJournal journal(project_file);
+  filter_data.set_journal(&journal);
+  filter_data.filter_list().insert(80, filter_ptr(new CutFilter()));
+  filter_data.filter_list().remove(1);
+  filter_data.filter_list().change_start_frame(50, 60);
+  filter_data.filter_list().shift(60, 120, 10);
+  filter_data.set_jump_size(250);
+  journal.flush();
+  filter_data.set_journal(nullptr);
+
+  BOOST_CHECK_EQUAL(recovered(base), saved());
+}
+
+
+BOOST_AUTO_TEST_CASE(replay_should_not_depend_on_the_project_being_written_again)
+{
+  std::string base = saved();
+
+  FilterJournal journal(project_file);
+  filter_data.set_journal(&journal);
+  filter_data.filter_list().insert(80, filter_ptr(new CutFilter()));
+  filter_data.filter_list().shift(50, 120, 30);
+
+  journal.rotate();
+  std::string written = saved();
+  filter_data.filter_list().change_start_frame(1, 5);
+  journal.flush();
+  filter_data.set_journal(nullptr);
+
+  // Writing the project failed, or it didn't remove the previous journal
+  BOOST_CHECK_EQUAL(recovered(base), saved());
+  BOOST_CHECK_EQUAL(recovered(written), saved());
+
+  journal.remove_previous();
+  BOOST_CHECK_EQUAL(recovered(written), saved());
+}
+
+
+BOOST_AUTO_TEST_CASE(rotate_should_keep_the_records_not_yet_written)
+{
+  std::string base = saved();
+
+  FilterJournal journal(project_file);
+  filter_data.set_journal(&journal);
+  filter_data.filter_list().remove(50);
+  journal.rotate();
+  BOOST_CHECK_EQUAL(journal.records(), 0);
+
+  // Writing the project failed, so the previous journal is still there
+  filter_data.filter_list().remove(120);
+  journal.rotate();
+  BOOST_CHECK_EQUAL(journal.records(), 1);
+  journal.flush();
+  filter_data.set_journal(nullptr);
+
+  BOOST_CHECK_EQUAL(recovered(base), saved());
+}
+
+
+BOOST_AUTO_TEST_CASE(open_should_drop_a_record_interrupted_by_a_crash)
+{
+  std::string base = saved();
+
+  {
+    FilterJournal journal(project_file);
+    filter_data.set_journal(&journal);
+    filter_data.filter_list().remove(50);
+    journal.flush();
+    filter_data.set_journal(nullptr);
+  }
+  // The program crashed while writing a record
+  std::ofstream(project_file + ".journal", std::ios::app) << "I;80;delogo;1;2";
+
+  {
+    // Recovered and edited again, and crashed again
+    FilterJournal journal(project_file);
+    filter_data.set_journal(&journal);
+    filter_data.filter_list().insert(90, filter_ptr(new CutFilter()));
+    journal.flush();
+    filter_data.set_journal(nullptr);
+  }
+
+  BOOST_CHECK_EQUAL(recovered(base), saved());
+}
+
+
+BOOST_AUTO_TEST_CASE(open_should_write_the_header_again_if_it_was_interrupted)
+{
+  std::string base = saved();
+  std::ofstream(project_file + ".journal") << "MDL";
+
+  {
+    FilterJournal journal(project_file);
+    filter_data.set_journal(&journal);
+    filter_data.filter_list().remove(120);
+    journal.flush();
+    filter_data.set_journal(nullptr);
+  }
+
+  BOOST_CHECK_EQUAL(recovered(base), saved());
+}
+
+
+BOOST_AUTO_TEST_CASE(replay_should_return_false_without_a_journal)
+{
+  BOOST_CHECK(!FilterJournal::replay(project_file, filter_data));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+
+BOOST_AUTO_TEST_CASE(replay_should_ignore_an_interrupted_record)
+{
+  std::istringstream in(
+    "MDLJ1\n"
+    "R;50\n"
+    "I;60;delogo;1;2;3;4\n"
+    "R;1");
+
+  FilterData filter_data;
+  filter_data.filter_list().insert(1, filter_ptr(new NullFilter()));
+  filter_data.filter_list().insert(50, filter_ptr(new NullFilter()));
+  BOOST_CHECK(FilterJournal::replay(in, filter_data));
+
+  auto& filters = filter_data.filter_list();
+  BOOST_CHECK_EQUAL(filters.size(), 2);
+  BOOST_CHECK(filters.get_by_start_frame(1));
+  BOOST_REQUIRE(filters.get_by_start_frame(60));
+  BOOST_CHECK_EQUAL(filters.get_by_start_frame(60)->second->type(), FilterType::DELOGO);
+}
+
+
+BOOST_AUTO_TEST_CASE(replay_should_fail_if_header_is_invalid)
+{
+  std::istringstream in(
+    "MDLV1\n"
+    "R;50\n");
+
+  FilterData filter_data;
+  BOOST_CHECK_THROW(FilterJournal::replay(in, filter_data), InvalidFilterDataException);
+}
+
+
+BOOST_AUTO_TEST_CASE(replay_should_fail_if_record_is_invalid)
+{
+  std::istringstream in(
+    "MDLJ1\n"
+    "X;50\n");
+
+  FilterData filter_data;
+  BOOST_CHECK_THROW(FilterJournal::replay(in, filter_data), InvalidFilterDataException);
+}
@@ -350,6 +350,147 @@ BOOST_AUTO_TEST_CASE(should_return_false_for_has_review_when_there_is_no_review_
 }
 
 
+BOOST_AUTO_TEST_CASE(should_return_spans_of_a_filter_type)
+{
+  FilterList list;
+  list.insert(1, filter_ptr(new ReviewFilter()));
+  list.insert(51, filter_ptr(new DelogoFilter(1, 2, 3, 4)));
+  list.insert(101, filter_ptr(new ReviewFilter()));
+  list.insert(151, filter_ptr(new ReviewFilter()));
+  list.insert(201, filter_ptr(new DelogoFilter(10, 20, 30, 40)));
+  list.insert(301, filter_ptr(new ReviewFilter()));
+
+  auto spans = list.spans_of_type(FilterType::REVIEW, 500);
+
+  BOOST_REQUIRE(spans.size() == 4);
+  BOOST_TEST(spans[0].first == 1);
+  BOOST_TEST(spans[0].second == 50);
+  BOOST_TEST(spans[1].first == 101);
+  BOOST_TEST(spans[1].second == 150);
+  BOOST_TEST(spans[2].first == 151);
+  BOOST_TEST(spans[2].second == 200);
+  BOOST_TEST(spans[3].first == 301);
+  BOOST_TEST(spans[3].second == 500);
+}
+
+
+BOOST_AUTO_TEST_CASE(should_return_no_spans_if_type_is_not_used)
+{
+  FilterList list;
+  list.insert(51, filter_ptr(new DelogoFilter(1, 2, 3, 4)));
+
+  BOOST_TEST(list.spans_of_type(FilterType::REVIEW, 500).empty());
+}
+
+
+BOOST_AUTO_TEST_CASE(merge_should_replace_filters_from_a_frame)
+{
+  FilterList list;
+  list.insert(1, filter_ptr(new DelogoFilter(10, 15, 100, 20)));
+  list.insert(301, filter_ptr(new ReviewFilter()));
+  list.insert(601, filter_ptr(new ReviewFilter()));
+
+  FilterList other;
+  other.insert(201, filter_ptr(new NullFilter()));
+  other.insert(501, filter_ptr(new DrawboxFilter(1, 2, 3, 4)));
+  other.insert(901, filter_ptr(new CutFilter()));
+
+  list.merge(other, 501);
+
+  BOOST_CHECK_EQUAL(list.size(), 4);
+  auto it = list.begin();
+  BOOST_CHECK_EQUAL(it->first, 1);
+  BOOST_CHECK_EQUAL(it->second->type(), FilterType::DELOGO);
+  ++it;
+  BOOST_CHECK_EQUAL(it->first, 301);
+  BOOST_CHECK_EQUAL(it->second->type(), FilterType::REVIEW);
+  ++it;
+  BOOST_CHECK_EQUAL(it->first, 501);
+  BOOST_CHECK_EQUAL(it->second->type(), FilterType::DRAWBOX);
+  ++it;
+  BOOST_CHECK_EQUAL(it->first, 901);
+  BOOST_CHECK_EQUAL(it->second->type(), FilterType::CUT);
+}
+
+
+BOOST_AUTO_TEST_CASE(merge_with_empty_list_should_truncate)
+{
+  FilterList list;
+  list.insert(1, filter_ptr(new DelogoFilter(10, 15, 100, 20)));
+  list.insert(301, filter_ptr(new ReviewFilter()));
+
+  FilterList other;
+  list.merge(other, 2);
+
+  BOOST_CHECK_EQUAL(list.size(), 1);
+  BOOST_CHECK_EQUAL(list.begin()->first, 1);
+}
+
+
+BOOST_AUTO_TEST_CASE(shift_should_move_filters_in_range)
+{
+  FilterList list;
+  for (int i = 0; i <= 9; ++i) {
+    list.insert(100*i + 1, filter_ptr(new DelogoFilter(i, i, i, i)));
+  }
+
+  auto frames = list.shift(300, 611, -1);
+
+  BOOST_CHECK_EQUAL(frames.first, 301);
+  BOOST_CHECK_EQUAL(frames.second, 601);
+  BOOST_CHECK_EQUAL(list.size(), 10);
+  auto it = list.begin();
+  for (int i = 0; i <= 9; ++i, ++it) {
+    int expected = (i >= 3 && i <= 6) ? 100*i : 100*i + 1;
+    BOOST_CHECK_EQUAL(it->first, expected);
+    BOOST_CHECK_EQUAL(std::static_pointer_cast<DelogoFilter>(it->second)->x(), i);
+  }
+}
+
+
+BOOST_AUTO_TEST_CASE(shift_should_replace_filters_at_new_start_frames)
+{
+  FilterList list;
+  list.insert(1, filter_ptr(new NullFilter()));
+  list.insert(101, filter_ptr(new DelogoFilter(1, 1, 1, 1)));
+  list.insert(201, filter_ptr(new DelogoFilter(2, 2, 2, 2)));
+  list.insert(251, filter_ptr(new CutFilter()));
+  list.insert(301, filter_ptr(new ReviewFilter()));
+
+  auto frames = list.shift(100, 201, 150);
+
+  BOOST_CHECK_EQUAL(frames.first, 101);
+  BOOST_CHECK_EQUAL(frames.second, 201);
+  BOOST_CHECK_EQUAL(list.size(), 4);
+  auto it = list.begin();
+  BOOST_CHECK_EQUAL(it->first, 1);
+  ++it;
+  BOOST_CHECK_EQUAL(it->first, 251);
+  BOOST_CHECK_EQUAL(it->second->type(), FilterType::DELOGO);
+  ++it;
+  BOOST_CHECK_EQUAL(it->first, 301);
+  BOOST_CHECK_EQUAL(it->second->type(), FilterType::REVIEW);
+  ++it;
+  BOOST_CHECK_EQUAL(it->first, 351);
+  BOOST_CHECK_EQUAL(it->second->type(), FilterType::DELOGO);
+}
+
+
+BOOST_AUTO_TEST_CASE(shift_without_filters_in_range_should_do_nothing)
+{
+  FilterList list;
+  list.insert(1, filter_ptr(new NullFilter()));
+  list.insert(301, filter_ptr(new ReviewFilter()));
+
+  auto frames = list.shift(2, 300, 10);
+
+  BOOST_CHECK_EQUAL(frames.first, 0);
+  BOOST_CHECK_EQUAL(frames.second, 0);
+  BOOST_CHECK_EQUAL(list.size(), 2);
+  BOOST_CHECK_EQUAL(list.begin()->first, 1);
+}
+
+
 BOOST_AUTO_TEST_CASE(should_load_a_list)
 {
   std::istringstream in(
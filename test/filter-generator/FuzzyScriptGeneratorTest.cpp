@@ -198,3 +198,18 @@ BOOST_AUTO_TEST_CASE(should_generate_ffmpeg_script_with_scale)
   std::getline(result, line);
   BOOST_TEST(line == "[out_v]");
 }
+
+
+BOOST_AUTO_TEST_CASE(should_not_use_drawbox_timeline)
+{
+  FilterList list;
+  list.insert(1, filter_ptr(new DrawboxFilter(10, 11, 12, 13)));
+  list.insert(101, filter_ptr(new DrawboxFilter(20, 21, 22, 23)));
+  std::shared_ptr<FuzzyScriptGenerator> g = FuzzyScriptGenerator::create(list, 1280, 720, 25, 2, boost::none, boost::none);
+  g->set_drawbox_timeline(true);
+
+  std::ostringstream out;
+  g->generate_ffmpeg_script(out);
+
+  BOOST_TEST(out.str().find("sendcmd") == std::string::npos);
+}
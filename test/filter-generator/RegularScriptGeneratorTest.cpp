@@ -19,6 +19,8 @@
 #include <clocale>
 #include <memory>
 #include <string>
+#include <vector>
+#include <regex>
 #include <sstream>
 
 #include "FilterList.hpp"
@@ -239,3 +241,243 @@ BOOST_AUTO_TEST_CASE(should_calculate_number_of_frames_in_result)
   int result = g->resulting_frames(3000);
   BOOST_TEST(result == 1600);
 }
+
+
+BOOST_AUTO_TEST_CASE(should_generate_script_with_cuts_first)
+{
+  FilterList list;
+  list.insert(1, filter_ptr(new DelogoFilter(10, 11, 12, 13)));
+  list.insert(601, filter_ptr(new CutFilter()));
+  list.insert(1001, filter_ptr(new DrawboxFilter(20, 21, 22, 23)));
+  std::shared_ptr<RegularScriptGenerator> g = RegularScriptGenerator::create(list, 1280, 720, 25, boost::none, boost::none);
+  g->set_cuts_first(true);
+
+  std::ostringstream out;
+  g->generate_ffmpeg_script(out);
+
+  std::string expected =
+    "[0:v]\n"
+    "select='not(between(n,600,999))',setpts=N/FRAME_RATE/TB,\n"
+    "delogo=enable='between(n,0,599)':x=10:y=11:w=12:h=13,\n"
+    "drawbox=enable='gte(n,600)':x=20:y=21:w=22:h=23:c=black:t=fill\n"
+    "[out_v];\n"
+    "[0:a]aselect='not(between(t,600/25.000000,999/25.000000))',asetpts=N/SR/TB[out_a]";
+  BOOST_CHECK_EQUAL(out.str(), expected);
+}
+
+
+/*
+ * Simulates the video part of a generated script over a number of
+ * frames, returning for each frame in the output the original frame
+ * number and the filters applied to it.
+ */
+std::vector<std::string> simulate_script(const std::string& script, int total_frames)
+{
+  struct Frame
+  {
+    int original;
+    std::string applied;
+  };
+
+  std::vector<Frame> frames;
+  for (int f = 0; f < total_frames; ++f) {
+    frames.push_back({f, ""});
+  }
+
+  std::string video = script.substr(0, script.find("\n[out_v]"));
+  video = video.substr(video.find('\n') + 1);
+
+  std::regex split_re(",\n");
+  std::regex range_re("(between|gte)\\(n,(\\d+)(,(\\d+))?\\)");
+  std::regex enable_re("enable='[^']*':");
+
+  std::sregex_token_iterator end;
+  for (std::sregex_token_iterator i(video.begin(), video.end(), split_re, -1); i != end; ++i) {
+    std::string step = *i;
+
+    std::vector<std::pair<int, int>> ranges;
+    for (std::sregex_iterator m(step.begin(), step.end(), range_re); m != std::sregex_iterator(); ++m) {
+      int start = std::stoi((*m)[2]);
+      int last = (*m)[1] == "gte" ? total_frames : std::stoi((*m)[4]);
+      ranges.push_back(std::make_pair(start, last));
+    }
+    auto in_ranges = [&ranges](int n) {
+      for (auto& r: ranges) {
+        if (n >= r.first && n <= r.second) {
+          return true;
+        }
+      }
+      return false;
+    };
+
+    std::vector<Frame> result;
+    for (int n = 0; n < int(frames.size()); ++n) {
+      Frame frame = frames[n];
+      if (step.find("select=") == 0) {
+        if (in_ranges(n)) {
+          continue;
+        }
+      } else if (in_ranges(n)) {
+        frame.applied += std::regex_replace(step, enable_re, "") + ";";
+      }
+      result.push_back(frame);
+    }
+    frames = result;
+  }
+
+  std::vector<std::string> ret;
+  for (auto& frame: frames) {
+    ret.push_back(std::to_string(frame.original) + " " + frame.applied);
+  }
+  return ret;
+}
+
+
+void check_cuts_first_is_equivalent(const FilterList& list, int total_frames)
+{
+  std::shared_ptr<RegularScriptGenerator> standard = RegularScriptGenerator::create(list, 1280, 720, 25, boost::none, boost::none);
+  std::ostringstream standard_out;
+  standard->generate_ffmpeg_script(standard_out);
+
+  std::shared_ptr<RegularScriptGenerator> cuts_first = RegularScriptGenerator::create(list, 1280, 720, 25, boost::none, boost::none);
+  cuts_first->set_cuts_first(true);
+  std::ostringstream cuts_first_out;
+  cuts_first->generate_ffmpeg_script(cuts_first_out);
+
+  auto expected = simulate_script(standard_out.str(), total_frames);
+  auto result = simulate_script(cuts_first_out.str(), total_frames);
+  BOOST_REQUIRE_EQUAL(result.size(), expected.size());
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    BOOST_REQUIRE_EQUAL(result[i], expected[i]);
+  }
+  BOOST_TEST(cuts_first->resulting_frames(total_frames) == standard->resulting_frames(total_frames));
+}
+
+
+BOOST_AUTO_TEST_CASE(cuts_first_should_be_equivalent_with_cuts_in_the_middle)
+{
+  FilterList list;
+  list.insert(1, filter_ptr(new DelogoFilter(10, 11, 12, 13)));
+  list.insert(301, filter_ptr(new CutFilter()));
+  list.insert(401, filter_ptr(new DrawboxFilter(20, 21, 22, 23)));
+  list.insert(901, filter_ptr(new CutFilter()));
+  list.insert(1201, filter_ptr(new NullFilter()));
+  list.insert(1501, filter_ptr(new DelogoFilter(30, 31, 32, 33)));
+
+  check_cuts_first_is_equivalent(list, 2000);
+}
+
+
+BOOST_AUTO_TEST_CASE(cuts_first_should_be_equivalent_with_cuts_at_the_start_and_end)
+{
+  FilterList list;
+  list.insert(1, filter_ptr(new CutFilter()));
+  list.insert(101, filter_ptr(new DelogoFilter(10, 11, 12, 13)));
+  list.insert(601, filter_ptr(new DrawboxFilter(20, 21, 22, 23)));
+  list.insert(801, filter_ptr(new CutFilter()));
+
+  check_cuts_first_is_equivalent(list, 1000);
+}
+
+
+BOOST_AUTO_TEST_CASE(cuts_first_should_be_equivalent_with_consecutive_cuts)
+{
+  FilterList list;
+  list.insert(51, filter_ptr(new DelogoFilter(10, 11, 12, 13)));
+  list.insert(201, filter_ptr(new CutFilter()));
+  list.insert(251, filter_ptr(new CutFilter()));
+  list.insert(301, filter_ptr(new DelogoFilter(20, 21, 22, 23)));
+  list.insert(302, filter_ptr(new CutFilter()));
+  list.insert(303, filter_ptr(new DrawboxFilter(30, 31, 32, 33)));
+
+  check_cuts_first_is_equivalent(list, 600);
+}
+
+
+BOOST_AUTO_TEST_CASE(cuts_first_should_not_change_script_without_cuts)
+{
+  FilterList list;
+  list.insert(1, filter_ptr(new DelogoFilter(10, 11, 12, 13)));
+  list.insert(501, filter_ptr(new DrawboxFilter(20, 21, 22, 23)));
+  std::shared_ptr<RegularScriptGenerator> standard = RegularScriptGenerator::create(list, 1280, 720, 25, boost::none, boost::none);
+  std::shared_ptr<RegularScriptGenerator> cuts_first = RegularScriptGenerator::create(list, 1280, 720, 25, boost::none, boost::none);
+  cuts_first->set_cuts_first(true);
+
+  std::ostringstream standard_out;
+  standard->generate_ffmpeg_script(standard_out);
+  std::ostringstream cuts_first_out;
+  cuts_first->generate_ffmpeg_script(cuts_first_out);
+
+  BOOST_CHECK_EQUAL(cuts_first_out.str(), standard_out.str());
+}
+
+
+BOOST_AUTO_TEST_CASE(should_generate_script_with_drawbox_timeline)
+{
+  FilterList list;
+  list.insert(1, filter_ptr(new DrawboxFilter(10, 11, 12, 13)));
+  list.insert(51, filter_ptr(new DelogoFilter(20, 21, 22, 23)));
+  list.insert(101, filter_ptr(new DrawboxFilter(30, 31, 32, 33)));
+  list.insert(201, filter_ptr(new NullFilter()));
+  std::shared_ptr<RegularScriptGenerator> g = RegularScriptGenerator::create(list, 1280, 720, 25, boost::none, boost::none);
+  g->set_drawbox_timeline(true);
+
+  std::ostringstream out;
+  g->generate_ffmpeg_script(out);
+
+  std::string expected =
+    "[0:v]\n"
+    "delogo=enable='between(n,50,99)':x=20:y=21:w=22:h=23,\n"
+    "sendcmd=c='0.000000-1.980000 drawbox@mdl_box x 10, drawbox@mdl_box y 11, drawbox@mdl_box w 12, drawbox@mdl_box h 13, drawbox@mdl_box enable 1;\n"
+    "1.980000-3.980000 drawbox@mdl_box enable 0;\n"
+    "3.980000-7.980000 drawbox@mdl_box x 30, drawbox@mdl_box y 31, drawbox@mdl_box w 32, drawbox@mdl_box h 33, drawbox@mdl_box enable 1;\n"
+    "7.980000 drawbox@mdl_box enable 0',\n"
+    "drawbox@mdl_box=enable='0':x=10:y=11:w=12:h=13:c=black:t=fill\n"
+    "[out_v]";
+  BOOST_CHECK_EQUAL(out.str(), expected);
+}
+
+
+BOOST_AUTO_TEST_CASE(drawbox_timeline_should_use_frames_after_cuts_when_cuts_are_first)
+{
+  FilterList list;
+  list.insert(1, filter_ptr(new DrawboxFilter(10, 11, 12, 13)));
+  list.insert(101, filter_ptr(new CutFilter()));
+  list.insert(201, filter_ptr(new DrawboxFilter(30, 31, 32, 33)));
+  std::shared_ptr<RegularScriptGenerator> g = RegularScriptGenerator::create(list, 1280, 720, 10, boost::none, boost::none);
+  g->set_cuts_first(true);
+  g->set_drawbox_timeline(true);
+
+  std::ostringstream out;
+  g->generate_ffmpeg_script(out);
+
+  std::string expected =
+    "[0:v]\n"
+    "select='not(between(n,100,199))',setpts=N/FRAME_RATE/TB,\n"
+    "sendcmd=c='0.000000-9.950000 drawbox@mdl_box x 10, drawbox@mdl_box y 11, drawbox@mdl_box w 12, drawbox@mdl_box h 13, drawbox@mdl_box enable 1;\n"
+    "9.950000 drawbox@mdl_box x 30, drawbox@mdl_box y 31, drawbox@mdl_box w 32, drawbox@mdl_box h 33, drawbox@mdl_box enable 1',\n"
+    "drawbox@mdl_box=enable='0':x=10:y=11:w=12:h=13:c=black:t=fill\n"
+    "[out_v];\n"
+    "[0:a]aselect='not(between(t,100/10.000000,199/10.000000))',asetpts=N/SR/TB[out_a]";
+  BOOST_CHECK_EQUAL(out.str(), expected);
+}
+
+
+BOOST_AUTO_TEST_CASE(drawbox_timeline_should_not_be_used_with_only_one_drawbox)
+{
+  FilterList list;
+  list.insert(1, filter_ptr(new DelogoFilter(10, 11, 12, 13)));
+  list.insert(501, filter_ptr(new DrawboxFilter(20, 21, 22, 23)));
+  std::shared_ptr<RegularScriptGenerator> g = RegularScriptGenerator::create(list, 1280, 720, 25, boost::none, boost::none);
+  g->set_drawbox_timeline(true);
+
+  std::ostringstream out;
+  g->generate_ffmpeg_script(out);
+
+  std::string expected =
+    "[0:v]\n"
+    "delogo=enable='between(n,0,499)':x=10:y=11:w=12:h=13,\n"
+    "drawbox=enable='gte(n,500)':x=20:y=21:w=22:h=23:c=black:t=fill\n"
+    "[out_v]";
+  BOOST_CHECK_EQUAL(out.str(), expected);
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+
+#include "FrameCache.hpp"
+
+using namespace mdl;
+
+
+#define BOOST_TEST_MODULE frame cache
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+
+BOOST_AUTO_TEST_CASE(should_return_false_for_frame_not_in_cache)
+{
+  FrameCache<std::string> cache(100);
+  std::string frame;
+
+  BOOST_TEST(!cache.get(1, frame));
+}
+
+
+BOOST_AUTO_TEST_CASE(should_return_frames_in_cache)
+{
+  FrameCache<std::string> cache(100);
+  cache.put(1, "frame 1", 10);
+  cache.put(2, "frame 2", 10);
+
+  std::string frame;
+  BOOST_TEST(cache.get(2, frame));
+  BOOST_TEST(frame == "frame 2");
+  BOOST_TEST(cache.get(1, frame));
+  BOOST_TEST(frame == "frame 1");
+  BOOST_TEST(cache.size() == 2);
+  BOOST_TEST(cache.bytes() == 20);
+}
+
+
+BOOST_AUTO_TEST_CASE(should_drop_least_recently_used_frames_when_full)
+{
+  FrameCache<std::string> cache(30);
+  cache.put(1, "frame 1", 10);
+  cache.put(2, "frame 2", 10);
+  cache.put(3, "frame 3", 10);
+
+  std::string frame;
+  cache.get(1, frame);
+  cache.put(4, "frame 4", 10);
+
+  BOOST_TEST(cache.get(1, frame));
+  BOOST_TEST(!cache.get(2, frame));
+  BOOST_TEST(cache.get(3, frame));
+  BOOST_TEST(cache.get(4, frame));
+  BOOST_TEST(cache.bytes() == 30);
+}
+
+
+BOOST_AUTO_TEST_CASE(should_replace_frame_already_in_cache)
+{
+  FrameCache<std::string> cache(100);
+  cache.put(1, "old", 10);
+  cache.put(1, "new", 20);
+
+  std::string frame;
+  BOOST_TEST(cache.get(1, frame));
+  BOOST_TEST(frame == "new");
+  BOOST_TEST(cache.size() == 1);
+  BOOST_TEST(cache.bytes() == 20);
+}
+
+
+BOOST_AUTO_TEST_CASE(should_keep_frame_larger_than_the_cache)
+{
+  FrameCache<std::string> cache(10);
+  cache.put(1, "frame 1", 5);
+  cache.put(2, "frame 2", 50);
+
+  std::string frame;
+  BOOST_TEST(!cache.get(1, frame));
+  BOOST_TEST(cache.get(2, frame));
+  BOOST_TEST(cache.size() == 1);
+}
@@ -426,4 +426,27 @@ BOOST_AUTO_TEST_CASE(should_shift_start_frames_forwards)
   }
 }
 
+BOOST_AUTO_TEST_CASE(should_shift_start_frames_past_other_filters)
+{
+  fg::FilterList list;
+  for (int i = 0; i <= 4; ++i) {
+    list.insert(100*i + 1, fg::filter_ptr(new fg::DelogoFilter(i, i, i, i)));
+  }
+  Glib::RefPtr<mdl::FilterListModel> model = mdl::FilterListModel::create(list);
+
+  std::pair<int, int> frames = model->shift_frames(100, 201, 150);
+
+  BOOST_CHECK_EQUAL(frames.first, 101);
+  BOOST_CHECK_EQUAL(frames.second, 201);
+
+  BOOST_CHECK_EQUAL(model->children().size(), 5);
+  std::vector<int> expected_start{1, 251, 301, 351, 401};
+  std::vector<int> expected_x{0, 1, 3, 2, 4};
+  for (int i = 0; i < 5; ++i) {
+    int start_frame = (*model->children()[i])[model->columns.start_frame];
+    BOOST_CHECK_EQUAL(start_frame, expected_start[i]);
+    test_start_frame_and_x(model, expected_start[i], expected_x[i]);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
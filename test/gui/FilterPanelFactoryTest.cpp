@@ -272,4 +272,48 @@ BOOST_AUTO_TEST_CASE(filter_panel_review_should_return_no_rectangle)
   BOOST_CHECK(!rect);
 }
 
+
+BOOST_AUTO_TEST_CASE(get_panel_should_reuse_the_panel_of_the_same_type)
+{
+  fg::filter_ptr first(new fg::DelogoFilter(1, 2, 3, 4));
+  fg::filter_ptr second(new fg::DelogoFilter(15, 20, 80, 40));
+  FilterPanel* first_panel = factory.get_panel(1, first);
+  FilterPanel* second_panel = factory.get_panel(100, second);
+
+  BOOST_CHECK_EQUAL(first_panel, second_panel);
+  BOOST_CHECK(!second_panel->is_changed());
+
+  auto rect = second_panel->get_rectangle();
+  BOOST_REQUIRE(rect);
+  BOOST_CHECK_EQUAL(rect->x, 15);
+  BOOST_CHECK_EQUAL(rect->y, 20);
+  BOOST_CHECK_EQUAL(rect->width, 80);
+  BOOST_CHECK_EQUAL(rect->height, 40);
+}
+
+
+BOOST_AUTO_TEST_CASE(get_panel_should_reset_the_panel_for_a_new_filter)
+{
+  fg::filter_ptr filter(new fg::DrawboxFilter(11, 22, 33, 44));
+  FilterPanel* panel = factory.get_panel(1, filter);
+  FilterPanel* new_panel = factory.get_panel(10, fg::FilterType::DRAWBOX);
+
+  BOOST_CHECK_EQUAL(panel, new_panel);
+
+  auto rect = new_panel->get_rectangle();
+  BOOST_REQUIRE(rect);
+  BOOST_CHECK_EQUAL(rect->x, 0);
+  BOOST_CHECK_EQUAL(rect->width, 0);
+}
+
+
+BOOST_AUTO_TEST_CASE(get_panel_should_create_a_panel_for_each_type)
+{
+  FilterPanel* delogo = factory.get_panel(1, fg::FilterType::DELOGO);
+  FilterPanel* cut = factory.get_panel(1, fg::FilterType::CUT);
+
+  BOOST_CHECK(delogo != cut);
+  BOOST_CHECK(dynamic_cast<FilterPanelCut*>(cut) != nullptr);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <thread>
+
+#include "SPSCQueue.hpp"
+
+using namespace mdl;
+
+
+#define BOOST_TEST_MODULE SPSC queue
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+
+BOOST_AUTO_TEST_CASE(should_return_false_when_empty)
+{
+  SPSCQueue<int> queue;
+  int value;
+
+  BOOST_TEST(!queue.pop(value));
+}
+
+
+BOOST_AUTO_TEST_CASE(should_pop_values_in_order)
+{
+  SPSCQueue<std::string> queue;
+  queue.push("a");
+  queue.push("b");
+  queue.push("c");
+
+  std::string value;
+  BOOST_TEST(queue.pop(value));
+  BOOST_TEST(value == "a");
+  BOOST_TEST(queue.pop(value));
+  BOOST_TEST(value == "b");
+  queue.push("d");
+  BOOST_TEST(queue.pop(value));
+  BOOST_TEST(value == "c");
+  BOOST_TEST(queue.pop(value));
+  BOOST_TEST(value == "d");
+  BOOST_TEST(!queue.pop(value));
+}
+
+
+BOOST_AUTO_TEST_CASE(should_free_values_not_popped)
+{
+  SPSCQueue<std::string> queue;
+  queue.push(std::string(1000, 'x'));
+  queue.push(std::string(1000, 'y'));
+}
+
+
+BOOST_AUTO_TEST_CASE(should_pass_values_between_threads)
+{
+  const int N = 100000;
+  SPSCQueue<int> queue;
+
+  std::thread producer([&queue] {
+      for (int i = 0; i < N; ++i) {
+        queue.push(i);
+      }
+    });
+
+  int expected = 0;
+  bool in_order = true;
+  while (expected < N) {
+    int value;
+    if (queue.pop(value)) {
+      in_order = in_order && value == expected;
+      ++expected;
+    }
+  }
+  producer.join();
+
+  BOOST_TEST(in_order);
+  int value;
+  BOOST_TEST(!queue.pop(value));
+}
@@ -18,6 +18,7 @@
  */
 #include <vector>
 #include <utility>
+#include <functional>
 
 #include "IntervalCalculator.hpp"
 
@@ -75,3 +76,76 @@ BOOST_AUTO_TEST_CASE(should_return_one_subinterval_for_third_level)
 }
 
 BOOST_AUTO_TEST_SUITE_END()
+
+
+BOOST_AUTO_TEST_SUITE(find_transition)
+
+BOOST_AUTO_TEST_CASE(should_find_transition_frame)
+{
+  for (int transition: {1001, 1002, 1025, 1026, 1500, 3333, 9999}) {
+    int found = IntervalCalculator::find_transition(1000, 10000, 25, 1000,
+      [transition](int frame) {
+        return frame < transition;
+      });
+    BOOST_TEST(found == transition);
+  }
+}
+
+
+BOOST_AUTO_TEST_CASE(should_return_end_if_always_present)
+{
+  int found = IntervalCalculator::find_transition(1000, 5000, 25, 1000,
+    [](int) {
+      return true;
+    });
+  BOOST_TEST(found == 5000);
+}
+
+
+BOOST_AUTO_TEST_CASE(should_check_few_frames)
+{
+  int checks = 0;
+  IntervalCalculator::find_transition(0, 100000, 25, 1600,
+    [&checks](int frame) {
+      ++checks;
+      return frame < 50001;
+    });
+  BOOST_TEST(checks < 60);
+}
+
+
+BOOST_AUTO_TEST_CASE(should_not_step_more_than_max_step)
+{
+  std::vector<int> frames;
+  IntervalCalculator::find_transition(0, 10000, 25, 100,
+    [&frames](int frame) {
+      frames.push_back(frame);
+      return true;
+    });
+
+  for (std::size_t i = 1; i < frames.size(); ++i) {
+    BOOST_TEST(frames[i] - frames[i - 1] <= 100);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+
+BOOST_AUTO_TEST_SUITE(count_samples)
+
+BOOST_AUTO_TEST_CASE(should_count_multiples_of_step)
+{
+  BOOST_TEST(IntervalCalculator::count_samples(0, 100, 10) == 10);
+  BOOST_TEST(IntervalCalculator::count_samples(0, 101, 10) == 11);
+  BOOST_TEST(IntervalCalculator::count_samples(5, 100, 10) == 9);
+  BOOST_TEST(IntervalCalculator::count_samples(10, 11, 10) == 1);
+}
+
+
+BOOST_AUTO_TEST_CASE(should_return_zero_if_no_multiple_in_interval)
+{
+  BOOST_TEST(IntervalCalculator::count_samples(11, 20, 10) == 0);
+  BOOST_TEST(IntervalCalculator::count_samples(20, 20, 10) == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,532 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <map>
+#include <iterator>
+#include <stdexcept>
+#include <chrono>
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+#include <getopt.h>
+#include <sys/stat.h>
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+#include <opencv2/videoio.hpp>
+
+#include "filter-generator/FilterData.hpp"
+#include "filter-generator/Filters.hpp"
+
+#include "gui/common/Exceptions.hpp"
+#include "OpenCVLogoFinder.hpp"
+#include "SyntheticClip.hpp"
+
+
+/*
+ * Benchmark for the logo finder. It runs each stage of
+ * OpenCVLogoFinder and the whole search over videos with a known
+ * logo timeline, reporting speed and detection accuracy.
+ *
+ * The synthetic videos are generated in the fixture directory on the
+ * first run, as uncompressed Y4M files. A recorded video can be used
+ * too, with a project file containing the correct filters.
+ *
+ * When a baseline file is given the results are compared to it, and
+ * the exit status is 1 if any metric regressed.
+ */
+
+
+namespace {
+  typedef mdl::opencv::ScriptedLogo Segment;
+
+
+  struct Fixture
+  {
+    std::string name;
+    std::string file;
+    int frame_interval_min;
+    int extra_frames;
+    std::vector<Segment> timeline;
+  };
+
+
+  struct Metric
+  {
+    std::string name;
+    double value;
+    std::string unit;
+    bool higher_is_better;
+  };
+
+
+  class Callback : public mdl::LogoFinderCallback
+  {
+  public:
+    std::vector<mdl::LogoFinderResult> results;
+
+    void success(const mdl::LogoFinderResult& result) override
+    {
+      results.push_back(result);
+    }
+
+    void failure(int start_frame, int end_frame) override
+    {
+    }
+  };
+
+
+  typedef std::chrono::steady_clock Clock;
+
+  double seconds_since(const Clock::time_point& start)
+  {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+  }
+}
+
+
+namespace mdl { namespace opencv {
+  /**
+   * Runs the stages of OpenCVLogoFinder separately, so they can be
+   * timed.
+   */
+  class OpenCVLogoFinderBenchmark
+  {
+  public:
+    OpenCVLogoFinderBenchmark(const Fixture& fixture, int repeat)
+      : fixture_(fixture)
+      , repeat_(repeat)
+      , finder_(fixture.file, callback_, false)
+    {
+      finder_.set_start_frame(0);
+      finder_.set_frame_interval_min(fixture.frame_interval_min);
+      finder_.set_extra_frames(fixture.extra_frames);
+    }
+
+    void run(std::vector<Metric>& metrics)
+    {
+      const std::string prefix = fixture_.name + ".";
+
+      int averaged_frames = 0;
+      double average_time = 0;
+      double find_box_time = 0;
+      int find_box_calls = 0;
+      double transition_time = 0;
+      int transition_calls = 0;
+      double transition_error = 0;
+
+      for (int i = 0; i < repeat_; ++i) {
+        for (const auto& segment: fixture_.timeline) {
+          if (segment.logo.area() == 0) {
+            continue;
+          }
+
+          int end = std::min(segment.start_frame + fixture_.frame_interval_min,
+                             segment.end_frame);
+          auto start = Clock::now();
+          finder_.average_frame(segment.start_frame, end);
+          average_time += seconds_since(start);
+          averaged_frames += end - segment.start_frame;
+
+          cv::filter2D(finder_.t_avg_, finder_.t_sharpened_, -1, finder_.kernel_sharpen_);
+          start = Clock::now();
+          for (int channel = 0; channel <= 2; ++channel) {
+            finder_.find_box_in_channel(finder_.t_sharpened_, channel);
+          }
+          find_box_time += seconds_since(start);
+          find_box_calls += 3;
+
+          int transition = segment.end_frame - fixture_.extra_frames / 2;
+          if (transition <= segment.start_frame
+              || segment.end_frame >= finder_.total_frames_) {
+            continue;
+          }
+          finder_.n_last_failures_ = 0;
+          finder_.go_to_frame(transition - 1);
+          finder_.advance_frame();
+          start = Clock::now();
+          int found = finder_.get_logo_transition_point(transition, segment.logo);
+          transition_time += seconds_since(start);
+          transition_error += std::abs(found - segment.end_frame);
+          ++transition_calls;
+        }
+      }
+
+      metrics.push_back({prefix + "average_frame.fps", averaged_frames / average_time,
+                         "frames/s", true});
+      metrics.push_back({prefix + "find_box_in_channel.time", 1000 * find_box_time / find_box_calls,
+                         "ms", false});
+      if (transition_calls > 0) {
+        metrics.push_back({prefix + "get_logo_transition_point.time", 1000 * transition_time / transition_calls,
+                           "ms", false});
+        metrics.push_back({prefix + "get_logo_transition_point.error", transition_error / transition_calls,
+                           "frames", false});
+      }
+    }
+
+  private:
+    const Fixture& fixture_;
+    int repeat_;
+    Callback callback_;
+    OpenCVLogoFinder finder_;
+  };
+} }
+
+
+namespace {
+  const int FRAME_WIDTH = 640;
+  const int FRAME_HEIGHT = 360;
+  const double FPS = 25;
+  const int SCENE_LENGTH = 40;
+
+
+  std::vector<Fixture> synthetic_fixtures(const std::string& dir)
+  {
+    std::vector<Fixture> fixtures;
+
+    fixtures.push_back({"moving", dir + "/moving.y4m", 500, 250, {
+          {0, 700, cv::Rect(520, 20, 100, 18)},
+          {700, 1350, cv::Rect(30, 25, 90, 16)},
+          {1350, 2150, cv::Rect(500, 310, 110, 20)},
+          {2150, 2900, cv::Rect(40, 300, 80, 14)}}});
+
+    fixtures.push_back({"sparse", dir + "/sparse.y4m", 500, 250, {
+          {0, 800, cv::Rect(510, 30, 100, 18)},
+          {800, 1400, cv::Rect()},
+          {1400, 2100, cv::Rect(510, 30, 100, 18)},
+          {2100, 2600, cv::Rect()},
+          {2600, 3300, cv::Rect(60, 310, 120, 20)}}});
+
+    return fixtures;
+  }
+
+
+  bool file_exists(const std::string& file)
+  {
+    struct stat info;
+    return stat(file.c_str(), &info) == 0;
+  }
+
+
+  /**
+   * The videos are uncompressed, so that the benchmark measures the
+   * logo finder and not the decoder. Each takes about 1 GB.
+   */
+  void generate_video(const Fixture& fixture)
+  {
+    mdl::opencv::SyntheticClip clip(FRAME_WIDTH, FRAME_HEIGHT, FPS);
+    clip.set_scene_length(SCENE_LENGTH);
+    clip.write(fixture.file, fixture.timeline);
+  }
+
+
+  /**
+   * Reads the timeline from a project file. The rectangle of each
+   * delogo or drawbox filter is the logo until the next filter.
+   */
+  std::vector<Segment> load_timeline(const std::string& project_file, int total_frames)
+  {
+    std::ifstream in(project_file);
+    if (!in) {
+      throw std::runtime_error("Could not open " + project_file);
+    }
+
+    fg::FilterData filter_data;
+    filter_data.load(in);
+    fg::FilterList& filters = filter_data.filter_list();
+
+    std::vector<Segment> timeline;
+    for (auto i = filters.begin(); i != filters.end(); ++i) {
+      auto next = std::next(i);
+      int start_frame = i->first - 1;
+      int end_frame = next == filters.end() ? total_frames : next->first - 1;
+
+      cv::Rect logo;
+      fg::FilterType type = i->second->type();
+      if (type == fg::FilterType::DELOGO || type == fg::FilterType::DRAWBOX) {
+        auto rect = std::static_pointer_cast<fg::RectangularFilter>(i->second);
+        logo = cv::Rect(rect->x(), rect->y(), rect->width(), rect->height());
+      }
+
+      timeline.push_back({start_frame, end_frame, logo});
+    }
+
+    return timeline;
+  }
+
+
+  double intersection_over_union(const cv::Rect& r1, const cv::Rect& r2)
+  {
+    double intersection = (r1 & r2).area();
+    double total = r1.area() + r2.area() - intersection;
+    return total > 0 ? intersection / total : 1;
+  }
+
+
+  /**
+   * Fraction of frames in which the finder gave the correct
+   * answer: no logo where there is none, or a box that overlaps the
+   * logo by at least half.
+   */
+  double frame_accuracy(const Fixture& fixture, const std::vector<mdl::LogoFinderResult>& results)
+  {
+    int total_frames = fixture.timeline.back().end_frame;
+    std::vector<cv::Rect> detected(total_frames);
+    for (const auto& result: results) {
+      cv::Rect box(result.x, result.y, result.width, result.height);
+      int end_frame = std::min(result.end_frame + 1, total_frames);
+      for (int f = std::max(result.start_frame, 0); f < end_frame; ++f) {
+        detected[f] = box;
+      }
+    }
+
+    int correct = 0;
+    for (const auto& segment: fixture.timeline) {
+      for (int f = segment.start_frame; f < segment.end_frame; ++f) {
+        if (segment.logo.area() == 0) {
+          correct += detected[f].area() == 0;
+        } else {
+          correct += intersection_over_union(segment.logo, detected[f]) >= 0.5;
+        }
+      }
+    }
+
+    return double(correct) / total_frames;
+  }
+
+
+  void run_find_logos(const Fixture& fixture, std::vector<Metric>& metrics)
+  {
+    Callback callback;
+    mdl::opencv::OpenCVLogoFinder finder(fixture.file, callback, false);
+    finder.set_start_frame(0);
+    finder.set_frame_interval_min(fixture.frame_interval_min);
+    finder.set_extra_frames(fixture.extra_frames);
+
+    auto start = Clock::now();
+    auto res = finder.find_logos();
+    double time = seconds_since(start);
+    if (!res.first) {
+      throw std::runtime_error(res.second);
+    }
+
+    int total_frames = fixture.timeline.back().end_frame;
+    metrics.push_back({fixture.name + ".find_logos.fps", total_frames / time,
+                       "frames/s", true});
+    metrics.push_back({fixture.name + ".find_logos.accuracy", frame_accuracy(fixture, callback.results),
+                       "", true});
+  }
+
+
+  std::map<std::string, double> load_baseline(const std::string& file)
+  {
+    std::ifstream in(file);
+    if (!in) {
+      throw std::runtime_error("Could not open " + file);
+    }
+
+    std::map<std::string, double> baseline;
+    std::string line;
+    while (std::getline(in, line)) {
+      if (line.empty() || line[0] == '#') {
+        continue;
+      }
+      std::istringstream line_in(line);
+      std::string name;
+      double value;
+      if (line_in >> name >> value) {
+        baseline[name] = value;
+      }
+    }
+
+    return baseline;
+  }
+
+
+  void save_baseline(const std::string& file, const std::vector<Metric>& metrics)
+  {
+    std::ofstream out(file);
+    if (!out) {
+      throw std::runtime_error("Could not create " + file);
+    }
+
+    out << "# Logo finder benchmark baseline, generated by LogoFinderBenchmark\n";
+    for (const auto& metric: metrics) {
+      out << metric.name << " " << metric.value << "\n";
+    }
+  }
+
+
+  /**
+   * Prints the metrics, comparing to the baseline if there is
+   * one. Accuracy must not drop at all; speed is allowed to vary by
+   * the tolerance, as timings are never exactly the same.
+   */
+  bool report(const std::vector<Metric>& metrics, const std::map<std::string, double>& baseline,
+              double tolerance)
+  {
+    bool regressed = false;
+
+    std::cout << std::fixed << std::setprecision(3);
+    for (const auto& metric: metrics) {
+      std::cout << std::left << std::setw(48) << metric.name
+                << std::right << std::setw(14) << metric.value << " " << std::setw(8) << metric.unit;
+
+      auto base = baseline.find(metric.name);
+      if (base != baseline.end()) {
+        bool is_accuracy = metric.unit.empty();
+        double allowed = is_accuracy ? 0 : tolerance * base->second;
+        double diff = metric.higher_is_better ? base->second - metric.value : metric.value - base->second;
+        std::cout << "  baseline " << std::setw(12) << base->second;
+        if (diff > allowed + 1e-9) {
+          std::cout << "  REGRESSION";
+          regressed = true;
+        }
+      }
+      std::cout << std::endl;
+    }
+
+    return !regressed;
+  }
+
+
+  void usage()
+  {
+    std::cout << "Usage: LogoFinderBenchmark [options]\n"
+              << "  --baseline=FILE        compare the results to FILE\n"
+              << "  --write-baseline=FILE  save the results to FILE\n"
+              << "  --tolerance=N          allowed slowdown, as a fraction (default 0.15)\n"
+              << "  --fixture-dir=DIR      where synthetic videos are stored (default benchmark-fixtures)\n"
+              << "  --video=FILE           use a recorded video instead of the synthetic ones\n"
+              << "  --truth=FILE           project file with the correct filters for --video\n"
+              << "  --interval=N           minimum frame interval for --video (default 500)\n"
+              << "  --extra=N              extra frames to check for --video (default 250)\n"
+              << "  --repeat=N             times to repeat the stage benchmarks (default 3)\n";
+  }
+}
+
+
+int main(int argc, char* argv[])
+{
+  std::string baseline_file;
+  std::string write_baseline_file;
+  double tolerance = 0.15;
+  std::string fixture_dir = "benchmark-fixtures";
+  std::string video_file;
+  std::string truth_file;
+  int interval = 500;
+  int extra = 250;
+  int repeat = 3;
+
+  const struct option long_options[] = {
+    {"baseline", required_argument, nullptr, 'b'},
+    {"write-baseline", required_argument, nullptr, 'w'},
+    {"tolerance", required_argument, nullptr, 't'},
+    {"fixture-dir", required_argument, nullptr, 'd'},
+    {"video", required_argument, nullptr, 'v'},
+    {"truth", required_argument, nullptr, 'T'},
+    {"interval", required_argument, nullptr, 'i'},
+    {"extra", required_argument, nullptr, 'e'},
+    {"repeat", required_argument, nullptr, 'r'},
+    {"help", no_argument, nullptr, 'h'},
+    {nullptr, 0, nullptr, 0}
+  };
+
+  int opt;
+  while ((opt = getopt_long(argc, argv, "h", long_options, nullptr)) != -1) {
+    switch (opt) {
+    case 'b': baseline_file = optarg; break;
+    case 'w': write_baseline_file = optarg; break;
+    case 't': tolerance = atof(optarg); break;
+    case 'd': fixture_dir = optarg; break;
+    case 'v': video_file = optarg; break;
+    case 'T': truth_file = optarg; break;
+    case 'i': interval = atoi(optarg); break;
+    case 'e': extra = atoi(optarg); break;
+    case 'r': repeat = std::max(atoi(optarg), 1); break;
+    case 'h': usage(); return 0;
+    default: usage(); return 2;
+    }
+  }
+
+  if (video_file.empty() != truth_file.empty()) {
+    std::cerr << "--video and --truth must be used together" << std::endl;
+    return 2;
+  }
+
+  try {
+    std::vector<Fixture> fixtures;
+    if (!video_file.empty()) {
+      cv::VideoCapture cap(video_file);
+      if (!cap.isOpened()) {
+        throw mdl::VideoNotOpenedException();
+      }
+      int total_frames = cap.get(cv::CAP_PROP_FRAME_COUNT);
+      auto timeline = load_timeline(truth_file, total_frames);
+      if (timeline.empty()) {
+        throw std::runtime_error("No filters in " + truth_file);
+      }
+      fixtures.push_back({"recorded", video_file, interval, extra, timeline});
+    } else {
+      mkdir(fixture_dir.c_str(), 0755);
+      fixtures = synthetic_fixtures(fixture_dir);
+      for (const auto& fixture: fixtures) {
+        if (!file_exists(fixture.file)) {
+          std::cout << "Generating " << fixture.file << std::endl;
+          generate_video(fixture);
+        }
+      }
+    }
+
+    std::vector<Metric> metrics;
+    for (const auto& fixture: fixtures) {
+      mdl::opencv::OpenCVLogoFinderBenchmark stages(fixture, repeat);
+      stages.run(metrics);
+      run_find_logos(fixture, metrics);
+    }
+
+    std::map<std::string, double> baseline;
+    if (!baseline_file.empty()) {
+      if (file_exists(baseline_file)) {
+        baseline = load_baseline(baseline_file);
+      } else {
+        std::cout << "No baseline at " << baseline_file << ", not comparing" << std::endl;
+      }
+    }
+
+    bool ok = report(metrics, baseline, tolerance);
+
+    if (!write_baseline_file.empty()) {
+      save_baseline(write_baseline_file, metrics);
+    }
+
+    return ok ? 0 : 1;
+  } catch (const mdl::Exception& e) {
+    std::cerr << e.what() << std::endl;
+    return 2;
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return 2;
+  }
+}
@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstdlib>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <opencv2/core.hpp>
+
+#include "gui/common/LogoFinder.hpp"
+#include "OpenCVLogoFinder.hpp"
+#include "SyntheticClip.hpp"
+
+using namespace mdl::opencv;
+
+
+#define BOOST_TEST_MODULE opencv logo finder
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+
+namespace {
+  class NullCallback : public mdl::LogoFinderCallback
+  {
+  public:
+    void success(const mdl::LogoFinderResult& result) override
+    {
+    }
+
+    void failure(int start_frame, int end_frame) override
+    {
+    }
+  };
+
+
+  class ResultsCallback : public mdl::LogoFinderCallback
+  {
+  public:
+    void success(const mdl::LogoFinderResult& result) override
+    {
+      results.push_back(result);
+    }
+
+    void failure(int start_frame, int end_frame) override
+    {
+    }
+
+    std::vector<mdl::LogoFinderResult> results;
+  };
+
+
+  class TransitionFixture
+  {
+  public:
+    TransitionFixture()
+      : first_logo(520, 20, 100, 18)
+      , second_logo(20, 20, 100, 18)
+    {
+      char dir_template[] = "/tmp/mdl-logo-finder-XXXXXX";
+      work_dir = mkdtemp(dir_template);
+      file = work_dir + "/clip.y4m";
+
+      SyntheticClip clip(640, 360, 25);
+      clip.set_scene_length(10);
+      clip.write(file, {{0, 230, first_logo}, {230, 400, second_logo}});
+    }
+
+    ~TransitionFixture()
+    {
+      std::remove(file.c_str());
+      rmdir(work_dir.c_str());
+    }
+
+    cv::Rect first_logo;
+    cv::Rect second_logo;
+    std::string work_dir;
+    std::string file;
+  };
+}
+
+
+namespace mdl { namespace opencv {
+  /** Gives the tests access to the steps of the search */
+  class OpenCVLogoFinderTest
+  {
+  public:
+    OpenCVLogoFinderTest()
+      : logo(520, 20, 100, 18)
+    {
+      char dir_template[] = "/tmp/mdl-logo-finder-XXXXXX";
+      work_dir = mkdtemp(dir_template);
+      file = work_dir + "/clip.y4m";
+
+      SyntheticClip clip(640, 360, 25);
+      clip.set_scene_length(10);
+      clip.write(file, {{0, 40, logo}});
+    }
+
+    ~OpenCVLogoFinderTest()
+    {
+      std::remove(file.c_str());
+      rmdir(work_dir.c_str());
+    }
+
+    cv::Rect find_boxes_progressive(int start_frame, int end_frame)
+    {
+      NullCallback callback;
+      OpenCVLogoFinder finder(file, callback, false);
+      finder.set_progressive(true);
+      return finder.find_boxes_progressive(start_frame, end_frame);
+    }
+
+    cv::Rect logo;
+    std::string work_dir;
+    std::string file;
+  };
+} }
+
+
+BOOST_FIXTURE_TEST_SUITE(progressive, OpenCVLogoFinderTest)
+
+BOOST_AUTO_TEST_CASE(should_search_an_interval_with_half_the_first_checkpoint)
+{
+  // Frames 0, 10, 20 and 30 are averaged, and no checkpoint is reached
+  cv::Rect box = find_boxes_progressive(0, 40);
+
+  BOOST_CHECK_LE(std::abs(box.x - logo.x), 3);
+  BOOST_CHECK_LE(std::abs(box.y - logo.y), 3);
+  BOOST_CHECK_LE(std::abs(box.width - logo.width), 6);
+  BOOST_CHECK_LE(std::abs(box.height - logo.height), 6);
+}
+
+
+BOOST_AUTO_TEST_CASE(should_find_nothing_in_an_interval_without_samples)
+{
+  cv::Rect box = find_boxes_progressive(1, 10);
+
+  BOOST_CHECK_EQUAL(box.area(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+
+BOOST_FIXTURE_TEST_SUITE(transition, TransitionFixture)
+
+BOOST_AUTO_TEST_CASE(should_find_the_end_of_a_logo_after_stopping_early)
+{
+  // The box is the same in the checkpoints at frames 70 and 150, so
+  // the averaging stops there, and the logo changes at frame 230,
+  // within the extra frames after the interval
+  ResultsCallback callback;
+  OpenCVLogoFinder finder(file, callback, false);
+  finder.set_start_frame(0);
+  finder.set_end_frame(400);
+  finder.set_frame_interval_min(200);
+  finder.set_extra_frames(100);
+  finder.set_progressive(true);
+  OpenCVLogoFinder::find_result result = finder.find_logos();
+
+  BOOST_REQUIRE(result.first);
+  BOOST_REQUIRE(!callback.results.empty());
+  BOOST_CHECK_EQUAL(callback.results[0].start_frame, 0);
+  BOOST_CHECK_EQUAL(callback.results[0].end_frame, 229);
+  BOOST_CHECK_LE(std::abs(callback.results[0].x - first_logo.x), 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
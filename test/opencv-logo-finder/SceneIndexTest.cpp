@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <vector>
+#include <sstream>
+
+#include "SceneIndex.hpp"
+
+using namespace mdl::opencv;
+
+
+#define BOOST_TEST_MODULE scene index
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+
+BOOST_AUTO_TEST_SUITE(find_cuts)
+
+BOOST_AUTO_TEST_CASE(should_find_cuts_above_minimum_difference)
+{
+  std::vector<double> differences{0, 1, 2, 1, 50, 1, 2, 1, 1, 40, 2};
+
+  auto cuts = SceneIndex::find_cuts(differences, 20, 3, 5);
+
+  std::vector<int> expected{4, 9};
+  BOOST_TEST(cuts == expected, boost::test_tools::per_element());
+}
+
+
+BOOST_AUTO_TEST_CASE(should_ignore_differences_similar_to_the_previous_frames)
+{
+  // A scene with a lot of motion, and then a cut
+  std::vector<double> differences{0, 25, 30, 28, 26, 31, 27, 29, 120, 3, 2};
+
+  auto cuts = SceneIndex::find_cuts(differences, 20, 3, 4);
+
+  std::vector<int> expected{1, 8};
+  BOOST_TEST(cuts == expected, boost::test_tools::per_element());
+}
+
+
+BOOST_AUTO_TEST_CASE(should_find_no_cuts_in_static_video)
+{
+  std::vector<double> differences(100, 0.5);
+
+  auto cuts = SceneIndex::find_cuts(differences, 20, 3, 10);
+
+  BOOST_TEST(cuts.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+
+BOOST_AUTO_TEST_SUITE(queries)
+
+BOOST_AUTO_TEST_CASE(should_return_cuts_between_frames)
+{
+  SceneIndex index(1000, {100, 200, 300, 400});
+
+  std::vector<int> expected{200, 300};
+  auto cuts = index.cuts_between(200, 400);
+  BOOST_TEST(cuts == expected, boost::test_tools::per_element());
+
+  BOOST_TEST(index.cuts_between(401, 1000).empty());
+}
+
+
+BOOST_AUTO_TEST_CASE(should_return_last_cut_between_frames)
+{
+  SceneIndex index(1000, {100, 200, 300, 400});
+
+  BOOST_TEST(index.last_cut_between(150, 400) == 300);
+  BOOST_TEST(index.last_cut_between(150, 401) == 400);
+  BOOST_TEST(index.last_cut_between(201, 300) == -1);
+  BOOST_TEST(index.last_cut_between(0, 100) == -1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+
+BOOST_AUTO_TEST_SUITE(load_and_save)
+
+BOOST_AUTO_TEST_CASE(should_load_saved_index)
+{
+  SceneIndex index(1000, {100, 200, 300});
+  std::stringstream file;
+  index.save(file);
+
+  SceneIndex loaded;
+  BOOST_TEST(loaded.load(file));
+  BOOST_TEST(loaded.total_frames() == 1000);
+  BOOST_TEST(loaded.cuts() == index.cuts(), boost::test_tools::per_element());
+}
+
+
+BOOST_AUTO_TEST_CASE(should_reject_invalid_index)
+{
+  SceneIndex index;
+
+  std::istringstream wrong_header("scenes\n1000\n100\n");
+  BOOST_TEST(!index.load(wrong_header));
+
+  std::istringstream unsorted("multi-delogo scenes 1\n1000\n200\n100\n");
+  BOOST_TEST(!index.load(unsorted));
+
+  std::istringstream out_of_range("multi-delogo scenes 1\n1000\n1000\n");
+  BOOST_TEST(!index.load(out_of_range));
+
+  std::istringstream garbage("multi-delogo scenes 1\n1000\n100\nx\n");
+  BOOST_TEST(!index.load(garbage));
+  BOOST_TEST(index.total_frames() == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
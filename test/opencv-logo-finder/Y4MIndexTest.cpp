@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+
+#include "gui/common/Exceptions.hpp"
+#include "Y4MIndex.hpp"
+
+using namespace mdl::opencv;
+
+
+#define BOOST_TEST_MODULE y4m index
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+
+namespace {
+  std::string frame(const std::string& header, std::size_t size, char value)
+  {
+    return header + std::string(size, value);
+  }
+}
+
+
+BOOST_AUTO_TEST_CASE(should_read_the_stream_header)
+{
+  std::string data = "YUV4MPEG2 W4 H2 F30000:1001 Ip A1:1 C420jpeg XYSCSS=420JPEG\n"
+                     + frame("FRAME\n", 12, 'a');
+
+  Y4MIndex index(data.data(), data.size());
+
+  BOOST_CHECK_EQUAL(index.width(), 4);
+  BOOST_CHECK_EQUAL(index.height(), 2);
+  BOOST_CHECK_CLOSE(index.fps(), 29.97, 0.01);
+  BOOST_CHECK(index.chroma() == Y4MIndex::Chroma::C420);
+  BOOST_CHECK_EQUAL(index.frame_size(), 12);
+}
+
+
+BOOST_AUTO_TEST_CASE(should_find_frames_with_parameters_in_their_headers)
+{
+  std::string header = "YUV4MPEG2 W4 H2 F25:1 C420\n";
+  std::string data = header
+                     + frame("FRAME\n", 12, 'a')
+                     + frame("FRAME Ip XCOMMENT\n", 12, 'b')
+                     + frame("FRAME\n", 12, 'c');
+
+  Y4MIndex index(data.data(), data.size());
+
+  BOOST_REQUIRE_EQUAL(index.number_of_frames(), 3);
+  BOOST_CHECK_EQUAL(index.frame_offset(0), header.size() + 6);
+  BOOST_CHECK_EQUAL(data[index.frame_offset(1)], 'b');
+  BOOST_CHECK_EQUAL(data[index.frame_offset(2)], 'c');
+}
+
+
+BOOST_AUTO_TEST_CASE(should_compute_the_size_of_each_chroma_format)
+{
+  std::string mono = "YUV4MPEG2 W4 H2 F25:1 Cmono\n";
+  BOOST_CHECK_EQUAL(Y4MIndex(mono.data(), mono.size()).frame_size(), 8);
+
+  std::string c422 = "YUV4MPEG2 W4 H2 F25:1 C422\n";
+  BOOST_CHECK_EQUAL(Y4MIndex(c422.data(), c422.size()).frame_size(), 16);
+
+  std::string c444 = "YUV4MPEG2 W4 H2 F25:1 C444\n";
+  BOOST_CHECK_EQUAL(Y4MIndex(c444.data(), c444.size()).frame_size(), 24);
+
+  // Odd sizes round the chroma up
+  std::string odd = "YUV4MPEG2 W5 H3 F25:1\n";
+  BOOST_CHECK_EQUAL(Y4MIndex(odd.data(), odd.size()).frame_size(), 15 + 2 * 6);
+}
+
+
+BOOST_AUTO_TEST_CASE(should_ignore_a_truncated_last_frame)
+{
+  std::string data = "YUV4MPEG2 W4 H2 F25:1\n"
+                     + frame("FRAME\n", 12, 'a')
+                     + frame("FRAME\n", 5, 'b');
+
+  Y4MIndex index(data.data(), data.size());
+
+  BOOST_CHECK_EQUAL(index.number_of_frames(), 1);
+}
+
+
+BOOST_AUTO_TEST_CASE(should_reject_unsupported_streams)
+{
+  std::string not_y4m = "RIFF....AVI LIST";
+  BOOST_CHECK(!Y4MIndex::is_y4m(not_y4m.data(), not_y4m.size()));
+  BOOST_CHECK_THROW(Y4MIndex(not_y4m.data(), not_y4m.size()), mdl::VideoNotOpenedException);
+
+  std::string no_size = "YUV4MPEG2 F25:1\n";
+  BOOST_CHECK_THROW(Y4MIndex(no_size.data(), no_size.size()), mdl::VideoNotOpenedException);
+
+  std::string ten_bits = "YUV4MPEG2 W4 H2 F25:1 C420p10\n";
+  BOOST_CHECK_THROW(Y4MIndex(ten_bits.data(), ten_bits.size()), mdl::VideoNotOpenedException);
+}
@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2018-2025 Werner Turing <werner.turing@protonmail.com>
+ *
+ * This file is part of multi-delogo.
+ *
+ * multi-delogo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * multi-delogo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with multi-delogo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <vector>
+
+#include "filter-generator/Filters.hpp"
+
+#include "FilterRenderer.hpp"
+
+using namespace mdl::opencv;
+
+
+#define BOOST_TEST_MODULE filter renderer
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+
+struct Image
+{
+  Image(int width, int height, int channels, unsigned char value)
+    : pixels(width * height * channels, value)
+    , buffer{.data = pixels.data(),
+             .width = width, .height = height,
+             .stride = width * channels, .channels = channels}
+  {
+  }
+
+  unsigned char& at(int x, int y, int channel = 0)
+  {
+    return pixels[y * buffer.stride + x * buffer.channels + channel];
+  }
+
+  std::vector<unsigned char> pixels;
+  ImageBuffer buffer;
+};
+
+
+BOOST_AUTO_TEST_SUITE(delogo)
+
+BOOST_AUTO_TEST_CASE(should_interpolate_from_border)
+{
+  Image image(3, 3, 1, 0);
+  unsigned char values[] = {10, 20, 30,
+                            40,  0, 60,
+                            70, 80, 90};
+  std::copy(values, values + 9, image.pixels.begin());
+
+  FilterRenderer::delogo(image.buffer, 1, 1, 1, 1);
+
+  BOOST_TEST(image.at(1, 1) == 50);
+  BOOST_TEST(image.at(0, 0) == 10);
+  BOOST_TEST(image.at(2, 1) == 60);
+}
+
+
+BOOST_AUTO_TEST_CASE(should_keep_uniform_image)
+{
+  Image image(20, 10, 3, 128);
+  image.at(5, 5, 1) = 255;
+
+  FilterRenderer::delogo(image.buffer, 3, 2, 8, 6);
+
+  for (unsigned char p: image.pixels) {
+    BOOST_TEST(p == 128);
+  }
+}
+
+
+BOOST_AUTO_TEST_CASE(should_handle_channels_separately)
+{
+  Image image(10, 10, 3, 0);
+  for (int y = 0; y < 10; ++y) {
+    for (int x = 0; x < 10; ++x) {
+      image.at(x, y, 0) = 10;
+      image.at(x, y, 1) = 100;
+      image.at(x, y, 2) = 200;
+    }
+  }
+  image.at(4, 4, 0) = 0;
+  image.at(4, 4, 2) = 0;
+
+  FilterRenderer::delogo(image.buffer, 2, 2, 5, 5);
+
+  BOOST_TEST(image.at(4, 4, 0) == 10);
+  BOOST_TEST(image.at(4, 4, 1) == 100);
+  BOOST_TEST(image.at(4, 4, 2) == 200);
+}
+
+
+BOOST_AUTO_TEST_CASE(should_stay_inside_frame_for_filter_at_edge)
+{
+  Image image(10, 10, 1, 50);
+  image.at(0, 0) = 0;
+  image.at(9, 9) = 0;
+
+  fg::DelogoFilter filter(0, 0, 10, 10);
+  FilterRenderer::render(filter, image.buffer);
+
+  BOOST_TEST(image.at(0, 0) == 0);
+  BOOST_TEST(image.at(9, 9) == 0);
+  BOOST_TEST(image.at(5, 5) == 50);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+
+BOOST_AUTO_TEST_SUITE(drawbox)
+
+BOOST_AUTO_TEST_CASE(should_fill_rectangle_with_black)
+{
+  Image image(10, 8, 3, 255);
+
+  fg::DrawboxFilter filter(2, 3, 4, 2);
+  FilterRenderer::render(filter, image.buffer);
+
+  for (int y = 0; y < 8; ++y) {
+    for (int x = 0; x < 10; ++x) {
+      bool inside = x >= 2 && x < 6 && y >= 3 && y < 5;
+      BOOST_TEST(image.at(x, y, 1) == (inside ? 0 : 255));
+    }
+  }
+}
+
+
+BOOST_AUTO_TEST_CASE(should_use_frame_size_for_zero_width)
+{
+  Image image(10, 8, 1, 255);
+
+  FilterRenderer::drawbox(image.buffer, 5, 1, 0, 1);
+
+  BOOST_TEST(image.at(4, 1) == 255);
+  BOOST_TEST(image.at(9, 1) == 0);
+  BOOST_TEST(image.at(9, 2) == 255);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+
+BOOST_AUTO_TEST_CASE(should_ignore_cut_filter)
+{
+  Image image(4, 4, 1, 7);
+
+  fg::CutFilter filter;
+  FilterRenderer::render(filter, image.buffer);
+
+  for (unsigned char p: image.pixels) {
+    BOOST_TEST(p == 7);
+  }
+}